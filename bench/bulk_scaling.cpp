@@ -0,0 +1,52 @@
+// bulk_scaling.cpp
+// Measures BulkParser throughput for 1 to N threads
+// Usage: bulk_scaling <file with one report per line> [max threads] [repeats]
+#include "../include/metaf_bulk.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <reports file> [max threads] [repeats]\n";
+        return 1;
+    }
+    std::ifstream file(argv[1]);
+    if (!file) {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return 1;
+    }
+    std::vector<std::string> reports;
+    std::string line;
+    while (std::getline(file, line)) reports.push_back(line);
+
+    const size_t maxThreads = (argc > 2) ?
+        std::strtoul(argv[2], nullptr, 10) : metaf::WorkStealingPool::defaultThreadCount();
+    const int repeats = (argc > 3) ? std::atoi(argv[3]) : 3;
+
+    std::printf("%zu reports, best of %d runs\n", reports.size(), repeats);
+    std::printf("threads  seconds  reports/s  speedup\n");
+    double singleThreadSeconds = 0.0;
+    for (size_t threads = 1; threads <= maxThreads; threads++) {
+        metaf::BulkParser parser(threads);
+        double best = 0.0;
+        size_t groups = 0;
+        for (int r = 0; r < repeats; r++) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto results = parser.parse(reports);
+            const std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+            if (!r || elapsed.count() < best) best = elapsed.count();
+            groups = 0;
+            for (const auto & result : results) groups += result.groups.size();
+        }
+        if (threads == 1) singleThreadSeconds = best;
+        std::printf("%7zu  %7.3f  %9.0f  %7.2f  (%zu groups)\n",
+            threads, best, reports.size() / best, singleThreadSeconds / best, groups);
+    }
+    return 0;
+}
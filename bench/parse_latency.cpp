@@ -0,0 +1,126 @@
+// parse_latency.cpp
+// Measures per-report parse latency percentiles with and without the limits
+// of ParseOptions, on a corpus of reports (by default bench/pathological.txt)
+// and on the corpus supplemented with long pathological reports generated
+// from the patterns which cost most per byte (long groups, long lists of
+// weather events, directions or cloud types, long runs of appended or merged
+// groups)
+// bench/pathological.txt is a fuzz corpus (mutated real and synthetic
+// reports) minimised to the slowest reports which together produce every
+// combination of report part, group type, validity and previous group type,
+// and every report type and error, that the whole corpus produced
+// Usage: parse_latency [file with one report per line] [repeats]
+#include "../include/metaf.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::string repeat(const std::string & s, size_t count, const std::string & separator = "") {
+    std::string result;
+    for (size_t i = 0; i < count; i++) {
+        if (i) result += separator;
+        result += s;
+    }
+    return result;
+}
+
+static std::vector<std::string> pathologicalReports() {
+    const std::string header = "METAR KXXX 081700Z 18010KT 9999 ";
+    const std::string tafHeader = "TAF KXXX 081700Z 0818/0924 18010KT 9999 ";
+    std::vector<std::string> reports;
+    std::mt19937 random(1);
+    for (size_t count = 10; count <= 100000; count *= 10) {
+        reports.push_back(header + std::string(count * 10, 'A'));
+        reports.push_back(header + std::string(count * 10, '/'));
+        reports.push_back(header + std::string(count * 10, '1'));
+        reports.push_back(header + "RMK RA" + repeat("B01E02", count));
+        reports.push_back(header + repeat("+TSRAGS", count));
+        reports.push_back(header + "RMK LTG DSNT " + repeat("N-NE-", count) + "N");
+        reports.push_back(header + "RMK " + repeat("CU1SC2", count));
+        reports.push_back(header + repeat("1 1/2SM", count, " "));
+        reports.push_back(header + repeat("1", count, " "));
+        reports.push_back(header + repeat("WS", count, " "));
+        reports.push_back(header + "RMK " + repeat("RAB20E30", count, " "));
+        reports.push_back(tafHeader + repeat("PROB30 TEMPO 0818/0820", count, " "));
+        // Random groups of characters used in reports
+        const std::string chars = "0123456789ABCDEFGKMNOPRSTVWZ/+-";
+        std::string junk = header;
+        for (size_t i = 0; i < count * 10; i++)
+            junk += (random() % 8) ? chars[random() % chars.size()] : ' ';
+        reports.push_back(junk);
+    }
+    return reports;
+}
+
+struct Latencies {
+    double p50, p99, p999, max;
+    size_t limitErrors;
+};
+
+static Latencies measure(const std::vector<std::string> & reports,
+    const metaf::ParseOptions & options,
+    int repeats)
+{
+    metaf::ParserContext context;
+    std::vector<double> latencies;
+    latencies.reserve(reports.size() * repeats);
+    size_t limitErrors = 0;
+    for (int r = 0; r < repeats; r++) {
+        for (const auto & report : reports) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto & result = metaf::Parser::parse(report, context, options);
+            const std::chrono::duration<double, std::micro> elapsed =
+                std::chrono::steady_clock::now() - start;
+            latencies.push_back(elapsed.count());
+            if (!r && result.reportMetadata.error == metaf::ReportError::PARSE_LIMIT_EXCEEDED)
+                limitErrors++;
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](double p) {
+        return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+    return Latencies{percentile(0.5), percentile(0.99), percentile(0.999), latencies.back(), limitErrors};
+}
+
+int main(int argc, char ** argv) {
+    const char * fileName = (argc > 1) ? argv[1] : "bench/pathological.txt";
+    std::ifstream file(fileName);
+    if (!file) {
+        std::cerr << "Cannot open " << fileName << "\n";
+        return 1;
+    }
+    std::vector<std::string> corpus;
+    std::string line;
+    while (std::getline(file, line)) corpus.push_back(line);
+    const int repeats = (argc > 2) ? std::atoi(argv[2]) : 3;
+    auto supplemented = corpus;
+    const auto generated = pathologicalReports();
+    supplemented.insert(supplemented.end(), generated.begin(), generated.end());
+
+    metaf::ParseOptions limited;
+    limited.maxReportLength = 4096;
+    limited.maxSteps = 1000;
+
+    std::printf("%zu reports from %s, %zu generated, %d runs\n",
+        corpus.size(), fileName, generated.size(), repeats);
+    std::printf("input      limits     p50 us   p99 us  p99.9 us    max us  limit errors\n");
+    for (const auto & [inputName, reports] :
+        {std::make_pair("corpus", &corpus), std::make_pair("+generated", &supplemented)})
+    {
+        for (const auto & [name, options] :
+            {std::make_pair("none", metaf::ParseOptions()), std::make_pair("set", limited)})
+        {
+            const auto l = measure(*reports, options, repeats);
+            std::printf("%-10s %-6s  %9.2f %8.2f %9.2f %9.2f  %12zu\n",
+                inputName, name, l.p50, l.p99, l.p999, l.max, l.limitErrors);
+        }
+    }
+    return 0;
+}
@@ -65,7 +65,80 @@ func ExplainReport(input string) (*ReportExplanation, error) {
 	// Assuming GetRawGroups() returns an object with Size() and Get(i) methods
 	// like the original example code structure.
 	explanationsVector := parseResult.GetRawGroups()
-	numExplanations := int(explanationsVector.Size())
+	explanations := make([]string, int(explanationsVector.Size()))
+	for i := range explanations {
+		explanations[i] = explanationsVector.Get(i)
+	}
+	explanation.Groups = pairGroups(originalGroups, explanations)
+
+	return explanation, nil
+}
+
+// Separators of the packed format returned by ParseMetafBatch. They never occur
+// within fields, but explanations may contain other control characters such as
+// newlines.
+const (
+	batchReportSeparator = "\x1e"
+	batchFieldSeparator  = "\x1f"
+	batchGroupSeparator  = "\x1d"
+	batchFieldCount      = 6
+)
+
+// ExplainReports parses and explains several METAR/TAF strings with a single
+// call into the C++ library, which amortises the cgo overhead over the batch.
+// The returned explanations are in the same order as the inputs.
+func ExplainReports(inputs []string) ([]*ReportExplanation, error) {
+	if len(inputs) == 0 {
+		return nil, nil
+	}
+	trimmedInputs := make([]string, len(inputs))
+	for i, input := range inputs {
+		// Newlines separate reports in the batch; within a report they are
+		// just group delimiters
+		trimmedInputs[i] = strings.TrimSpace(strings.ReplaceAll(input, "\n", " "))
+		if trimmedInputs[i] == "" {
+			return nil, fmt.Errorf("input report string %d cannot be empty", i)
+		}
+	}
+
+	packed := ParseMetafBatch(strings.Join(trimmedInputs, "\n"))
+	records := strings.Split(strings.TrimSuffix(packed, batchReportSeparator), batchReportSeparator)
+	if len(records) != len(inputs) {
+		return nil, fmt.Errorf("expected %d parse results, got %d", len(inputs), len(records))
+	}
+
+	explanations := make([]*ReportExplanation, len(records))
+	for i, record := range records {
+		fields := strings.Split(record, batchFieldSeparator)
+		if len(fields) != batchFieldCount || len(fields[4]) != 6 {
+			return nil, fmt.Errorf("malformed parse result for report %d", i)
+		}
+		flags := fields[4]
+		explanations[i] = &ReportExplanation{
+			ReportType:     fields[0],
+			Error:          fields[1],
+			Location:       fields[2],
+			Timestamp:      fields[3],
+			IsSpeci:        flags[0] == '1',
+			IsAutomated:    flags[1] == '1',
+			IsNil:          flags[2] == '1',
+			IsCancelled:    flags[3] == '1',
+			IsAmended:      flags[4] == '1',
+			IsCorrectional: flags[5] == '1',
+		}
+		var groupExplanations []string
+		if fields[5] != "" {
+			groupExplanations = strings.Split(fields[5], batchGroupSeparator)
+		}
+		explanations[i].Groups = pairGroups(splitMaintainingQuotedGroups(trimmedInputs[i]), groupExplanations)
+	}
+	return explanations, nil
+}
+
+// pairGroups pairs the raw groups of a report with their explanations.
+func pairGroups(originalGroups []string, explanations []string) []GroupExplanation {
+	groups := []GroupExplanation{}
+	numExplanations := len(explanations)
 	numRawGroups := len(originalGroups)
 
 	// Determine the number of groups to process (minimum of raw vs explained)
@@ -84,14 +157,14 @@ func ExplainReport(input string) (*ReportExplanation, error) {
 	// Process each group, pairing raw string with its explanation
 	for i := 0; i < numGroupsToProcess; i++ {
 		rawGroup := originalGroups[i]
-		explanationText := explanationsVector.Get(i) // Get the explanation string
+		explanationText := explanations[i] // Get the explanation string
 
 		// Ensure explanationText uses standard newlines \n (no <br>)
 		// The C++ part should ideally provide this directly.
 		// If the C++ *still* adds <br>, we would need to replace them here:
 		// explanationText = strings.ReplaceAll(explanationText, "<br>", "\n")
 
-		explanation.Groups = append(explanation.Groups, GroupExplanation{
+		groups = append(groups, GroupExplanation{
 			RawGroup:    rawGroup,
 			Explanation: explanationText,
 		})
@@ -100,14 +173,14 @@ func ExplainReport(input string) (*ReportExplanation, error) {
 	// Handle any remaining raw groups that didn't get an explanation
 	if numRawGroups > numExplanations {
 		for i := numExplanations; i < numRawGroups; i++ {
-			explanation.Groups = append(explanation.Groups, GroupExplanation{
+			groups = append(groups, GroupExplanation{
 				RawGroup:    originalGroups[i],
 				Explanation: "[No explanation generated]", // Indicate missing explanation
 			})
 		}
 	}
 
-	return explanation, nil
+	return groups
 }
 
 // splitMaintainingQuotedGroups splits a string by spaces while keeping quoted sections together.
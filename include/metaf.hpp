@@ -19,14 +19,41 @@
 	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
 #endif
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <variant>
 #include <optional>
-#include <regex>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+// SIMD is used to find group delimiters in the report, unless METAF_NO_SIMD
+// is defined; SSE2 is always available on x86-64 and AVX2 is selected at
+// runtime if supported by CPU
+#if !defined(METAF_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+	#define METAF_SIMD_SSE2
+	#include <emmintrin.h>
+	#if defined(__GNUC__)
+		#define METAF_SIMD_AVX2
+		#include <immintrin.h>
+	#endif
+#endif
+
+// Numeric fields of up to 8 digits are validated and converted within a
+// single 64-bit word (SWAR) on little-endian targets, unless METAF_NO_SWAR
+// is defined
+#if !defined(METAF_NO_SWAR) && (defined(_MSC_VER) || \
+	(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__))
+	#define METAF_SWAR
+#endif
+
 namespace metaf {
 
 // Metaf library version
@@ -85,11 +112,154 @@ using Group = std::variant<
 	UnknownGroup
 >;
 
+// Index of group type T among the alternatives of group variant G (Group by
+// default) or number of alternatives in G if T is not one of them
+template <typename T, typename G = Group, size_t I = 0>
+constexpr size_t alternativeIndex() {
+	if constexpr (I >= std::variant_size_v<G>) {
+		return I;
+	} else if constexpr (std::is_same<std::variant_alternative_t<I, G>, T>::value) {
+		return I;
+	} else {
+		return alternativeIndex<T, G, I+1>();
+	}
+}
+
+template <typename T, typename G>
+constexpr bool isGroupAlternative() {
+	return (alternativeIndex<T, G>() < std::variant_size_v<G>);
+}
+
+// Same as std::get_if but also accepts group variants which do not have T
+// among their alternatives (and always returns nullptr for them)
+template <typename T, typename G>
+const T * getGroupIf(const G & group) {
+	if constexpr (isGroupAlternative<T, G>()) {
+		return std::get_if<T>(&group);
+	} else {
+		(void)group;
+		return nullptr;
+	}
+}
+
+// Set of group types; bit I corresponds to alternative I of Group, also
+// when used with a trimmed group variant
+using GroupTypeMask = std::uint32_t;
+static_assert(std::variant_size_v<Group> <= sizeof(GroupTypeMask) * 8,
+	"GroupTypeMask is too narrow for Group alternatives");
+
+template <typename... Types>
+constexpr GroupTypeMask groupTypeMask() {
+	return ((GroupTypeMask(1) << alternativeIndex<Types>()) | ... | 0);
+}
+
+static const inline GroupTypeMask allGroupTypes = ~GroupTypeMask();
+
+// Bit of the type held by group variant G
+template <typename G>
+GroupTypeMask groupTypeOf(const G & group) {
+	return std::visit([](const auto & g) {
+		return groupTypeMask<std::decay_t<decltype(g)>>();
+	}, group);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+// Compact replacement for std::optional used to store values in groups
+// Value not set is represented by the largest value of the unsigned type,
+// the smallest value of the signed type, or NaN for the floating point type,
+// so that no extra flag (and padding) is needed
+template <typename T>
+class PackedOptional {
+public:
+	static_assert(std::is_arithmetic<T>::value,
+		"PackedOptional only stores arithmetic types");
+	PackedOptional() = default;
+	template <typename U>
+	PackedOptional(const std::optional<U> & v) :
+		packed(v.has_value() ? static_cast<T>(*v) : notSet()) {}
+	template <typename U,
+		typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	PackedOptional(U v) : packed(static_cast<T>(v)) {}
+
+	bool has_value() const {
+		if constexpr (std::is_floating_point<T>::value) {
+			return !std::isnan(packed);
+		} else {
+			return (packed != notSet());
+		}
+	}
+	T operator*() const { return packed; }
+	template <typename U>
+	U value_or(U v) const { return (has_value() ? static_cast<U>(packed) : v); }
+	template <typename U>
+	operator std::optional<U>() const {
+		if (!has_value()) return std::optional<U>();
+		return static_cast<U>(packed);
+	}
+
+private:
+	static constexpr T notSet() {
+		if constexpr (std::is_floating_point<T>::value) {
+			return std::numeric_limits<T>::quiet_NaN();
+		} else if constexpr (std::is_signed<T>::value) {
+			return std::numeric_limits<T>::min();
+		} else {
+			return std::numeric_limits<T>::max();
+		}
+	}
+	T packed = notSet();
+};
+
+// List which keeps first items inline and the rest in heap storage
+// This is used for the lists which are usually short but may occasionally be
+// long (such as weather events in remarks) so that the rare long lists do not
+// increase the size of every Group
+template <typename T, size_t InlineSize>
+class CompactList {
+public:
+	static_assert(InlineSize <= std::numeric_limits<uint8_t>::max(),
+		"Inline item count must fit into uint8_t");
+	CompactList() = default;
+	CompactList(const CompactList & other) { *this = other; }
+	CompactList(CompactList && other) = default;
+	CompactList & operator=(const CompactList & other) {
+		if (this == &other) return *this;
+		for (auto i = 0u; i < other.inlineCount; i++)
+			inlineItems[i] = other.inlineItems[i];
+		inlineCount = other.inlineCount;
+		overflow.reset();
+		if (other.overflow) overflow = std::make_unique<std::vector<T>>(*other.overflow);
+		return *this;
+	}
+	CompactList & operator=(CompactList && other) = default;
+
+	size_t size() const {
+		return (inlineCount + (overflow ? overflow->size() : 0));
+	}
+	const T & operator[](size_t i) const {
+		return (i < InlineSize ? inlineItems[i] : (*overflow)[i - InlineSize]);
+	}
+	void push_back(const T & item) {
+		if (inlineCount < InlineSize) {
+			inlineItems[inlineCount++] = item;
+			return;
+		}
+		if (!overflow) overflow = std::make_unique<std::vector<T>>();
+		overflow->push_back(item);
+	}
+
+private:
+	std::unique_ptr<std::vector<T>> overflow;
+	T inlineItems[InlineSize];
+	uint8_t inlineCount = 0;
+};
+
 ///////////////////////////////////////////////////////////////////////////
 
 class Runway {
 public:
-	enum class Designator {
+	enum class Designator : uint8_t {
 		NONE,
 		LEFT,
 		CENTER,
@@ -110,7 +280,7 @@ public:
 	}
 
 	Runway() = default;
-	static inline std::optional<Runway> fromString(const std::string & s, bool enableRwy = false);
+	static inline std::optional<Runway> fromString(std::string_view s, bool enableRwy = false);
 	static Runway makeAllRunways() {
 		Runway rw;
 		rw.rNumber = allRunwaysNumber;
@@ -120,7 +290,7 @@ public:
 private:
 	static inline std::optional<Designator> designatorFromChar(char c);
 
-	unsigned int rNumber = 0;
+	uint8_t rNumber = 0;
 	Designator rDesignator = Designator::NONE;
 	static const unsigned int allRunwaysNumber = 88;
 	static const unsigned int messageRepetitionNumber = 99;
@@ -151,13 +321,14 @@ public:
 		unsigned int hour,
 		unsigned int minute) :
 			dayValue(day), hourValue(hour), minuteValue(minute) {}
-	static inline std::optional<MetafTime> fromStringDDHHMM(const std::string & s);
-	static inline std::optional<MetafTime> fromStringDDHH(const std::string & s);
+	static inline std::optional<MetafTime> fromStringDDHHMM(std::string_view s);
+	static inline std::optional<MetafTime> fromStringDDHH(std::string_view s);
 
 private:
-	std::optional<unsigned int> dayValue;
-	unsigned int hourValue = 0;
-	unsigned int minuteValue = 0;
+	// Day, hour and minute are two-digit fields in the report
+	PackedOptional<uint8_t> dayValue;
+	uint8_t hourValue = 0;
+	uint8_t minuteValue = 0;
 
 	static const inline unsigned int dayNotReported = 0;
 	static const inline unsigned int maxDay = 31;
@@ -169,7 +340,7 @@ class Speed;
 
 class Temperature {
 public:
-	enum class Unit {
+	enum class Unit : uint8_t {
 		C,
 		F,
 	};
@@ -194,12 +365,12 @@ public:
 		const Speed & windSpeed);
 
 	Temperature () = default;
-	static inline std::optional<Temperature> fromString(const std::string & s);
-	static inline std::optional<Temperature> fromRemarkString(const std::string & s);
+	static inline std::optional<Temperature> fromString(std::string_view s);
+	static inline std::optional<Temperature> fromRemarkString(std::string_view s);
 private:
 	inline Temperature (float value);
 
-	std::optional<int> tempValue;
+	PackedOptional<int16_t> tempValue;
 	bool freezing = false;
 	static const Unit tempUnit = Unit::C;
 	bool precise = false; //True = tenth of degrees C, false = degrees C
@@ -208,7 +379,7 @@ private:
 
 class Speed {
 public:
-	enum class Unit {
+	enum class Unit : uint8_t {
 		KNOTS,
 		METERS_PER_SECOND,
 		KILOMETERS_PER_HOUR,
@@ -220,11 +391,11 @@ public:
 	bool isReported() const { return speedValue.has_value(); }
 
 	Speed() = default;
-	static inline std::optional<Speed> fromString(const std::string & s, Unit unit);
-	static inline std::optional<Unit> unitFromString(const std::string & s);
+	static inline std::optional<Speed> fromString(std::string_view s, Unit unit);
+	static inline std::optional<Unit> unitFromString(std::string_view s);
 
 private:
-	std::optional<unsigned int> speedValue;
+	PackedOptional<uint16_t> speedValue;
 	Unit speedUnit = Unit::KNOTS;
 
 	static inline std::optional<float> knotsToUnit(float valueKnots, Unit otherUnit);
@@ -235,19 +406,19 @@ private:
 
 class Distance {
 public:
-	enum class Unit {
+	enum class Unit : uint8_t {
 		METERS,
 		STATUTE_MILES,
 		FEET
 	};
-	enum class Modifier {
+	enum class Modifier : uint8_t {
 		NONE,
 		LESS_THAN,
 		MORE_THAN,
 		DISTANT,
 		VICINITY
 	};
-	enum class MilesFraction {
+	enum class MilesFraction : uint8_t {
 		NONE,
 		F_1_16,
 		F_1_8,
@@ -285,20 +456,20 @@ public:
 	Distance(Unit u) : distUnit(u) {}
 	static inline std::optional<Distance> fromIntegerAndFraction(const Distance & integer,
 		const Distance & fraction);
-	static inline std::optional<Distance> fromMeterString(const std::string & s);
-	static inline std::optional<Distance> fromMileString(const std::string & s,
+	static inline std::optional<Distance> fromMeterString(std::string_view s);
+	static inline std::optional<Distance> fromMileString(std::string_view s,
 		bool remarkFormat = false);
-	static inline std::optional<Distance> fromHeightString(const std::string & s);
-	static inline std::optional<Distance> fromRvrString(const std::string & s, bool unitFeet);
+	static inline std::optional<Distance> fromHeightString(std::string_view s);
+	static inline std::optional<Distance> fromRvrString(std::string_view s, bool unitFeet);
 	static inline std::optional< std::pair<Distance,Distance> > fromLayerString(
-		const std::string & s);
+		std::string_view s);
 	static inline Distance cavokVisibility(bool unitMiles = false);
-	static inline std::optional<Distance> fromKmString(const std::string & s);
+	static inline std::optional<Distance> fromKmString(std::string_view s);
 	static inline Distance makeDistant();
 	static inline Distance makeVicinity();
 private:
+	PackedOptional<uint32_t> dist;
 	Modifier distModifier = Modifier::NONE;
-	std::optional<unsigned int> dist;
 	Unit distUnit = Unit::METERS;
 
 	// If distance unit is statute mile, d stores value in 1/10000ths of mile
@@ -321,7 +492,7 @@ private:
 
 class Direction {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		NOT_REPORTED,	// Direction is specified as not reported
 		VARIABLE,		// Direction is reported as variable
 		NDV,			// Direction is reported as No Directional Variation
@@ -331,7 +502,7 @@ public:
 		ALQDS,			// Direction is reported as all quadrants (in all directions)
 		UNKNOWN 		// Direction is reported as unknown explicitly
 	};
-	enum class Cardinal {
+	enum class Cardinal : uint8_t {
 		NOT_REPORTED, // Not reported or no corresponding cardinal direction
 		VRB,	// Direction is variable
 		NDV,	// No Directional Variation
@@ -371,15 +542,15 @@ public:
 	static inline Cardinal rotateOctantClockwise(Cardinal cardinal);
 
 	Direction() = default;
-	static inline std::optional<Direction> fromCardinalString(const std::string & s,
+	static inline std::optional<Direction> fromCardinalString(std::string_view s,
 		bool enableOhdAlqds = false,
 		bool enableUnknown = false);
-	static inline std::optional<Direction> fromDegreesString(const std::string & s);
+	static inline std::optional<Direction> fromDegreesString(std::string_view s);
 	static inline std::optional<std::pair<Direction, Direction>> fromSectorString(
-		const std::string & s);
+		std::string_view s);
 
 private:
-	unsigned int dirDegrees = 0;
+	uint16_t dirDegrees = 0;
 	Type dirType = Type::NOT_REPORTED;
 private:
 	static const inline unsigned int maxDegrees = 360;
@@ -398,7 +569,7 @@ private:
 
 class Pressure {
 public:
-	enum class Unit {
+	enum class Unit : uint8_t {
 		HECTOPASCAL,
 		INCHES_HG,
 		MM_HG
@@ -409,14 +580,14 @@ public:
 	bool isReported() const { return pressureValue.has_value(); }
 
 	Pressure() = default;
-	static inline std::optional<Pressure> fromString(const std::string & s);
-	static inline std::optional<Pressure> fromForecastString(const std::string & s);
-	static inline std::optional<Pressure> fromSlpString(const std::string & s);
-	static inline std::optional<Pressure> fromQfeString(const std::string & s);
-	static inline std::optional<Pressure> fromTendencyString(const std::string & s);
+	static inline std::optional<Pressure> fromString(std::string_view s);
+	static inline std::optional<Pressure> fromForecastString(std::string_view s);
+	static inline std::optional<Pressure> fromSlpString(std::string_view s);
+	static inline std::optional<Pressure> fromQfeString(std::string_view s);
+	static inline std::optional<Pressure> fromTendencyString(std::string_view s);
 
 private:
-	std::optional<float> pressureValue;
+	PackedOptional<float> pressureValue;
 	Unit pressureUnit = Unit::HECTOPASCAL;
 
 	static inline const float inHgDecimalPointShift = 0.01;
@@ -425,7 +596,7 @@ private:
 
 class Precipitation {
 public:
-	enum class Unit {
+	enum class Unit : uint8_t {
 		MM,
 		INCHES,
 	};
@@ -435,17 +606,17 @@ public:
 	bool isReported() const { return precipValue.has_value(); }
 
 	Precipitation() = default;
-	static inline std::optional<Precipitation> fromRainfallString(const std::string & s);
-	static inline std::optional<Precipitation> fromRunwayDeposits(const std::string & s);
-	static inline std::optional<Precipitation> fromRemarkString(const std::string & s,
+	static inline std::optional<Precipitation> fromRainfallString(std::string_view s);
+	static inline std::optional<Precipitation> fromRunwayDeposits(std::string_view s);
+	static inline std::optional<Precipitation> fromRemarkString(std::string_view s,
 		float factor = 1,
 		Unit unit = Unit::INCHES,
 		bool allowNotReported = false);
 	static inline std::optional<std::pair<Precipitation, Precipitation> >
-		fromSnincrString(const std::string & s);
+		fromSnincrString(std::string_view s);
 
 private:
-	std::optional<float> precipValue;
+	PackedOptional<float> precipValue;
 	Unit precipUnit = Unit::MM;
 private:
 	// Special value for runway deposits depth, see Table 1079 in Manual on Codes (WMO No. 306).
@@ -464,13 +635,13 @@ private:
 
 class SurfaceFriction {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		NOT_REPORTED,
 		SURFACE_FRICTION_REPORTED,
 		BRAKING_ACTION_REPORTED,
 		UNRELIABLE 		// Value unreliable or unmeasurable.
 	};
-	enum class BrakingAction {
+	enum class BrakingAction : uint8_t {
 		NONE,			// Not reported or unreliable
 		POOR,	 		// Friction coef <0.26
 		MEDIUM_POOR,	// Friction coef 0.26 to 0.29
@@ -489,11 +660,11 @@ public:
 	bool isUnreliable() const { return (type() == Type::UNRELIABLE); }
 
 	SurfaceFriction() = default;
-	static inline std::optional<SurfaceFriction> fromString(const std::string & s);
+	static inline std::optional<SurfaceFriction> fromString(std::string_view s);
 
 private:
 	Type sfType = Type::NOT_REPORTED;
-	unsigned int sfCoefficient = 0; //0 to 100, multiply by 0.01 to get actual value
+	uint8_t sfCoefficient = 0; //0 to 100, multiply by 0.01 to get actual value
 	static const inline auto coefficientDecimalPointShift = 0.01;
 private:
 	// Special values for braking action, see Table 0366 in Manual on Codes (WMO No. 306).
@@ -517,16 +688,16 @@ private:
 
 class WaveHeight {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		STATE_OF_SURFACE,	// Descriptive state of surface is specified
 		WAVE_HEIGHT,		// Actual wave height is specified
 	};
-	enum class Unit {
+	enum class Unit : uint8_t {
 		METERS,
 		FEET,
 	};
 	// State of sea surface, see Table 3700 in Manual on Codes (WMO No. 306).
-	enum class StateOfSurface {
+	enum class StateOfSurface : uint8_t {
 		NOT_REPORTED,
 		CALM_GLASSY,
 		CALM_RIPPLED,
@@ -550,11 +721,11 @@ public:
 	inline std::optional<float> toUnit(Unit unit) const;
 
 	WaveHeight() = default;
-	static inline std::optional<WaveHeight> fromString(const std::string & s);
+	static inline std::optional<WaveHeight> fromString(std::string_view s);
 
 private:
 	Type whType = Type::STATE_OF_SURFACE;
-	std::optional<unsigned int> whValue; //in decimeters, muliply by 0.1 to get value in meters
+	PackedOptional<uint16_t> whValue; //in decimeters, muliply by 0.1 to get value in meters
 	static const inline auto waveHeightDecimalPointShift = 0.1;
 	static const Unit whUnit = Unit::METERS;
 private:
@@ -576,7 +747,7 @@ private:
 // Describes recent, current, or forecast weather phenomena
 class WeatherPhenomena {
 public:
-	enum class Qualifier {
+	enum class Qualifier : uint8_t {
 		NONE,
 		RECENT,
 		VICINITY,
@@ -584,7 +755,7 @@ public:
 		MODERATE,
 		HEAVY
 	};
-	enum class Descriptor {
+	enum class Descriptor : uint8_t {
 		NONE,
 		SHALLOW,
 		PARTIAL,
@@ -595,7 +766,7 @@ public:
 		THUNDERSTORM,
 		FREEZING
 	};
-	enum class Weather {
+	enum class Weather : uint8_t {
 		NOT_REPORTED,
 		DRIZZLE,
 		RAIN,
@@ -620,7 +791,7 @@ public:
 		SANDSTORM,
 		DUSTSTORM
 	};
-	enum class Event {
+	enum class Event : uint8_t {
 		NONE,
 		BEGINNING,
 		ENDING
@@ -634,10 +805,10 @@ public:
 	inline bool isValid() const;
 
 	WeatherPhenomena() = default;
-	static inline std::optional <WeatherPhenomena> fromString(const std::string & s,
+	static inline std::optional <WeatherPhenomena> fromString(std::string_view s,
 		bool enableQualifiers = false);
 	static inline std::optional <WeatherPhenomena> fromWeatherBeginEndString(
-		const std::string & s,
+		std::string_view s,
 		const MetafTime & reportTime,
 		const WeatherPhenomena & previous);
 	static WeatherPhenomena notReported(bool recent) {
@@ -707,11 +878,6 @@ private:
 		Weather w3 = Weather::NOT_REPORTED,
 		Event e = Event::NONE
 	);
-	inline static uint32_t pack(Qualifier q,
-		Descriptor d,
-		std::vector<Weather> w,
-		Event e = Event::NONE
-	);
 
 	// The following is to confirm that all enums cast to unsigned int
 	// fit into the specified amount of bits
@@ -766,7 +932,7 @@ private:
 
 class CloudType {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		NOT_REPORTED,
 		//Low clouds
 		CUMULONIMBUS,
@@ -806,27 +972,27 @@ public:
 	bool isValid() const { return (okt >= 1u && okt <= 8u); }
 
 	CloudType() = default;
-	CloudType(Type t, Distance h, unsigned int o) : tp(t), ht(h), okt(o) {}
-	static inline std::optional<CloudType> fromString(const std::string & s);
-	static inline std::optional<CloudType> fromStringObscuration(const std::string & s);
+	CloudType(Type t, Distance h, unsigned int o) : ht(h), tp(t), okt(o) {}
+	static inline std::optional<CloudType> fromString(std::string_view s);
+	static inline std::optional<CloudType> fromStringObscuration(std::string_view s);
 private:
-	Type tp = Type::NOT_REPORTED;
 	Distance ht;
-	unsigned int okt = 0u;
+	Type tp = Type::NOT_REPORTED;
+	uint8_t okt = 0u;
 
-	static inline Type cloudTypeFromString(const std::string & s);
-	static inline Type cloudTypeOrObscurationFromString(const std::string & s);
+	static inline Type cloudTypeFromString(std::string_view s);
+	static inline Type cloudTypeOrObscurationFromString(std::string_view s);
 };
 
 ///////////////////////////////////////////////////////////////////////////
 
-enum class ReportType {
+enum class ReportType : uint8_t {
 	UNKNOWN,
 	METAR,
 	TAF
 };
 
-enum class ReportPart {
+enum class ReportPart : uint8_t {
 	UNKNOWN,
 	HEADER,
 	METAR,
@@ -834,7 +1000,7 @@ enum class ReportPart {
 	RMK
 };
 
-enum class ReportError {
+enum class ReportError : uint8_t {
 	NONE,
 	EMPTY_REPORT,
 	EXPECTED_REPORT_TYPE_OR_LOCATION,
@@ -848,7 +1014,8 @@ enum class ReportError {
 	AMD_ALLOWED_IN_TAF_ONLY,
 	CNL_ALLOWED_IN_TAF_ONLY,
 	MAINTENANCE_INDICATOR_ALLOWED_IN_METAR_ONLY,
-	REPORT_TOO_LARGE
+	REPORT_TOO_LARGE,
+	PARSE_LIMIT_EXCEEDED
 };
 
 struct ReportMetadata {
@@ -877,7 +1044,7 @@ static const inline ReportMetadata missingMetadata;
 ///////////////////////////////////////////////////////////////////////////
 
 // Result of appending string to an existing group
-enum class AppendResult {
+enum class AppendResult : uint8_t {
 	// String was appended to the group (i.e. the string is a continuation of
 	// the previous group); all info from the string is already absorbed into
 	// the group; no need to parse the string.
@@ -919,7 +1086,7 @@ using FallbackGroup = UnknownGroup;
 
 class KeywordGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		METAR,
 		SPECI,
 		TAF,
@@ -941,10 +1108,10 @@ public:
 	bool isValid() const { return (true); }
 
 	KeywordGroup() = default;
-	static inline std::optional<KeywordGroup> parse(const std::string & group,
+	static inline std::optional<KeywordGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -952,6 +1119,7 @@ private:
 	Type t;
 	KeywordGroup(Type type) :t (type) {}
 };
+static_assert(sizeof(KeywordGroup) <= 1, "KeywordGroup exceeds its size budget");
 
 class LocationGroup {
 public:
@@ -959,10 +1127,10 @@ public:
 	inline bool isValid() const { return true; }
 
 	LocationGroup() = default;
-	static inline std::optional<LocationGroup> parse(const std::string & group,
+	static inline std::optional<LocationGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -970,6 +1138,7 @@ private:
 	static const inline auto locationLength = 4;
 	char location [locationLength + 1] = "\0";
 };
+static_assert(sizeof(LocationGroup) <= 5, "LocationGroup exceeds its size budget");
 
 class ReportTimeGroup {
 public:
@@ -978,20 +1147,21 @@ public:
 
 	ReportTimeGroup() = default;
 	static inline std::optional<ReportTimeGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
 private:
 	MetafTime t;
 };
+static_assert(sizeof(ReportTimeGroup) <= 3, "ReportTimeGroup exceeds its size budget");
 
 class TrendGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		NOSIG,
 		BECMG,
 		TEMPO,
@@ -1002,7 +1172,7 @@ public:
 		TIME_SPAN,
 		PROB
 	};
-	enum class Probability {
+	enum class Probability : uint8_t {
 		NONE,		// Probability not specified.
 		PROB_30,
 		PROB_40,
@@ -1023,10 +1193,10 @@ public:
 
 	TrendGroup() = default;
 	static inline std::optional<TrendGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1034,10 +1204,10 @@ private:
 	TrendGroup(Type type) : t(type) {}
 	TrendGroup(Probability p) : t(Type::PROB), prob(p) {}
 
-	static inline std::optional<TrendGroup> fromTimeSpan(const std::string & s);
-	static inline std::optional<TrendGroup> fromTimeSpanHHMM(const std::string & s);
-	static inline std::optional<TrendGroup> fromFm(const std::string & s);
-	static inline std::optional<TrendGroup> fromTrendTime(const std::string & s);
+	static inline std::optional<TrendGroup> fromTimeSpan(std::string_view s);
+	static inline std::optional<TrendGroup> fromTimeSpanHHMM(std::string_view s);
+	static inline std::optional<TrendGroup> fromFm(std::string_view s);
+	static inline std::optional<TrendGroup> fromTrendTime(std::string_view s);
 
 	inline bool combineProbAndTrendTypeGroups(const TrendGroup & nextTrendGroup);
 	inline bool combineTrendTypeAndTimeGroup(const TrendGroup & nextTrendGroup);
@@ -1058,10 +1228,11 @@ private:
 	std::optional<MetafTime> tTill;	// Time span end time.
 	std::optional<MetafTime> tAt;	// Precise time.
 };
+static_assert(sizeof(TrendGroup) <= 15, "TrendGroup exceeds its size budget");
 
 class WindGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		SURFACE_WIND,
 		SURFACE_WIND_CALM,
 		VARIABLE_WIND_SECTOR,
@@ -1087,14 +1258,14 @@ public:
 
 	WindGroup() = default;
 	static inline std::optional<WindGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
-	enum class IncompleteText {
+	enum class IncompleteText : uint8_t {
 		NONE,
 		PK,
 		PK_WND,
@@ -1105,12 +1276,14 @@ private:
 	WindGroup(Type type, IncompleteText incomplete = IncompleteText::NONE) :
 		windType(type), incompleteText(incomplete) {}
 	static inline std::optional<WindGroup> parseVariableSector(
-		const std::string & group);
-	inline AppendResult appendPeakWind(const std::string & group,
+		std::string_view group);
+	static inline std::size_t speedValueLength(std::string_view group,
+		std::size_t pos);
+	inline AppendResult appendPeakWind(std::string_view group,
 		const ReportMetadata & reportMetadata);
-	inline AppendResult appendWindShift(const std::string & group,
+	inline AppendResult appendWindShift(std::string_view group,
 		const ReportMetadata & reportMetadata);
-	inline AppendResult appendVariableSector(const std::string & group);
+	inline AppendResult appendVariableSector(std::string_view group);
 
 	Type windType;
 	Direction windDir;
@@ -1125,10 +1298,11 @@ private:
 	IncompleteText incompleteText = IncompleteText::NONE;
 
 };
+static_assert(sizeof(WindGroup) <= 40, "WindGroup exceeds its size budget");
 
 class VisibilityGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		PREVAILING,
 		PREVAILING_NDV,
 		DIRECTIONAL,
@@ -1147,7 +1321,7 @@ public:
 		RVRNO,
 		VISNO
 	};
-	enum class Trend {
+	enum class Trend : uint8_t {
 		NONE,
 		NOT_REPORTED,
 		UPWARD,
@@ -1176,14 +1350,14 @@ public:
 
 	VisibilityGroup() = default;
 	inline static std::optional<VisibilityGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
-	enum class IncompleteText {
+	enum class IncompleteText : uint8_t {
 		NONE,
 		INTEGER,
 		VIS,
@@ -1225,31 +1399,31 @@ private:
 		}
 	}
 
-	static inline std::optional<VisibilityGroup> fromIncompleteInteger(const std::string & group);
-	static inline std::optional<VisibilityGroup> fromMeters(const std::string & group);
-	static inline std::optional<VisibilityGroup> fromRvr(const std::string & group);
+	static inline std::optional<VisibilityGroup> fromIncompleteInteger(std::string_view group);
+	static inline std::optional<VisibilityGroup> fromMeters(std::string_view group);
+	static inline std::optional<VisibilityGroup> fromRvr(std::string_view group);
 
-	inline bool appendFractionToIncompleteInteger(const std::string & group,
+	inline bool appendFractionToIncompleteInteger(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendDirection(const std::string & group,
+	inline bool appendDirection(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendRunway(const std::string & group,
+	inline bool appendRunway(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendInteger(const std::string & group,
+	inline bool appendInteger(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendFraction(const std::string & group,
+	inline bool appendFraction(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendVariable(const std::string & group,
+	inline bool appendVariable(std::string_view group,
 		IncompleteText nextIfMaxIsInteger = IncompleteText::NONE,
 		IncompleteText nextIfMaxIsFraction = IncompleteText::NONE);
-	inline bool appendVariableMaxFraction(const std::string & group,
+	inline bool appendVariableMaxFraction(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendMeters(const std::string & group,
+	inline bool appendMeters(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendVariableMeters(const std::string & group,
+	inline bool appendVariableMeters(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
 
-	static inline Trend trendFromString(const std::string & s);
+	static inline Trend trendFromString(std::string_view s);
 
 	Type visType = Type::PREVAILING;
 	Distance vis;
@@ -1262,10 +1436,11 @@ private:
 
 	IncompleteText incompleteText = IncompleteText::NONE;
 };
+static_assert(sizeof(VisibilityGroup) <= 48, "VisibilityGroup exceeds its size budget");
 
 class CloudGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		NO_CLOUDS,
 		CLOUD_LAYER,
 		VERTICAL_VISIBILITY,
@@ -1275,7 +1450,7 @@ public:
 		CLD_MISG,
 		OBSCURATION
 	};
-	enum class Amount {
+	enum class Amount : uint8_t {
 		NOT_REPORTED,
 		NCD,
 		NSC,
@@ -1290,7 +1465,7 @@ public:
 		VARIABLE_SCATTERED_BROKEN,
 		VARIABLE_BROKEN_OVERCAST
 	};
-	enum class ConvectiveType {
+	enum class ConvectiveType : uint8_t {
 		NONE,
 		NOT_REPORTED,
 		TOWERING_CUMULUS,
@@ -1328,25 +1503,26 @@ public:
 
 	CloudGroup () = default;
 	static inline std::optional<CloudGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
-	Type tp = Type::CLOUD_LAYER;
-	Amount amnt = Amount::NOT_REPORTED;
+	// Members are ordered by alignment to avoid padding
 	Distance heightOrVertVis;
 	Distance maxHt;
-	ConvectiveType convtype = ConvectiveType::NONE;
 	WeatherPhenomena w;
-	std::optional<Runway> rw;
-	std::optional<Direction> dir;
 	CloudType cldTp;
+	std::optional<Direction> dir;
+	std::optional<Runway> rw;
+	Type tp = Type::CLOUD_LAYER;
+	Amount amnt = Amount::NOT_REPORTED;
+	ConvectiveType convtype = ConvectiveType::NONE;
 	static const inline auto heightNotReported = Distance(Distance::Unit::FEET);
 
-	enum class IncompleteText {
+	enum class IncompleteText : uint8_t {
 		NONE,
 		RMK_AMOUNT,
 		RMK_AMOUNT_V,
@@ -1360,21 +1536,22 @@ private:
 
 	CloudGroup(Type t, IncompleteText it) : tp(t), incompleteText(it) {}
 	CloudGroup(Type t, Amount a = Amount::NOT_REPORTED) : tp(t), amnt(a) {}
-	static inline std::optional<CloudGroup> parseCloudLayerOrVertVis(const std::string & s);
-	static inline std::optional<CloudGroup> parseVariableCloudLayer(const std::string & s);
-	static inline std::optional<Amount> amountFromString(const std::string & s);
-	static inline std::optional<ConvectiveType> convectiveTypeFromString(const std::string & s);
-	inline AppendResult appendVariableCloudAmount(const std::string & group);
-	inline AppendResult appendCeiling(const std::string & group);
-	inline AppendResult appendRunwayOrCardinalDirection(const std::string & group);
-	inline AppendResult appendObscuration(const std::string & group);
+	static inline std::optional<CloudGroup> parseCloudLayerOrVertVis(std::string_view s);
+	static inline std::optional<CloudGroup> parseVariableCloudLayer(std::string_view s);
+	static inline std::optional<Amount> amountFromString(std::string_view s);
+	static inline std::optional<ConvectiveType> convectiveTypeFromString(std::string_view s);
+	inline AppendResult appendVariableCloudAmount(std::string_view group);
+	inline AppendResult appendCeiling(std::string_view group);
+	inline AppendResult appendRunwayOrCardinalDirection(std::string_view group);
+	inline AppendResult appendObscuration(std::string_view group);
 	static inline unsigned int amountToMaxOkta(Amount a);
 	static inline CloudType::Type convectiveTypeToCloudTypeType(ConvectiveType t);
 };
+static_assert(sizeof(CloudGroup) <= 52, "CloudGroup exceeds its size budget");
 
 class WeatherGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		CURRENT,
 		RECENT,
 		EVENT,
@@ -1388,22 +1565,22 @@ public:
 	inline std::vector<WeatherPhenomena> weatherPhenomena() const;
 	bool isValid() const {
 		if (incompleteText != IncompleteText::NONE) return false;
-		for (auto i=0u; i < wsz; i++)
+		for (auto i=0u; i < w.size(); i++)
 			if (!w[i].isValid()) return false;
 		return true;
 	}
 
 	WeatherGroup() = default;
 	static inline std::optional<WeatherGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
 private:
-	enum class IncompleteText {
+	enum class IncompleteText : uint8_t {
 		NONE,
 		WX,
 		TSLTNG,
@@ -1412,10 +1589,9 @@ private:
 
 	inline bool addWeatherPhenomena(const WeatherPhenomena & wp);
 
-	Type t = Type::CURRENT;
 	static const inline size_t wSize = 20;
-	size_t wsz = 0;
-	WeatherPhenomena w[wSize];
+	CompactList<WeatherPhenomena, 4> w;
+	Type t = Type::CURRENT;
 	IncompleteText incompleteText = IncompleteText::NONE;
 
 	WeatherGroup(Type tp, IncompleteText i = IncompleteText::NONE) : t(tp), incompleteText(i) {}
@@ -1423,16 +1599,17 @@ private:
 	static inline WeatherGroup notReportedRecent();
 
 	static inline std::optional<WeatherPhenomena> parseWeatherWithoutEvent(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart);
 	static inline std::optional<WeatherGroup> parseWeatherEvent(
-		const std::string & group,
+		std::string_view group,
 		const MetafTime & reportTime);
 };
+static_assert(sizeof(WeatherGroup) <= 56, "WeatherGroup exceeds its size budget");
 
 class TemperatureGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		TEMPERATURE_AND_DEW_POINT,
 		T_MISG,
 		TD_MISG
@@ -1447,10 +1624,10 @@ public:
 
 	TemperatureGroup() = default;
 	static inline std::optional<TemperatureGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1462,10 +1639,11 @@ private:
 
 	TemperatureGroup(Type t, bool i = false) : tp(t), isIncomplete(i) {}
 };
+static_assert(sizeof(TemperatureGroup) <= 12, "TemperatureGroup exceeds its size budget");
 
 class PressureGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		OBSERVED_QNH,			//Observed pressure normalised to sea level (altimeter setting)
 		FORECAST_LOWEST_QNH,	//Forecast lowest sea level pressure
 		OBSERVED_QFE,			//Observed actual (non-normalised) pressure
@@ -1479,10 +1657,10 @@ public:
 
 	PressureGroup() = default;
 	static inline std::optional<PressureGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1493,17 +1671,18 @@ private:
 
 	PressureGroup (Type tp, bool i = false) : t(tp), isIncomplete(i) {}
 };
+static_assert(sizeof(PressureGroup) <= 16, "PressureGroup exceeds its size budget");
 
 class RunwayStateGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		RUNWAY_STATE,
 		RUNWAY_CLRD,
 		RUNWAY_SNOCLO,
 		RUNWAY_NOT_OPERATIONAL,
 		AERODROME_SNOCLO
 	};
-	enum class Deposits {// Deposits type, see Table 0919 in Manual on Codes (WMO No. 306).
+	enum class Deposits : uint8_t {// Deposits type, see Table 0919 in Manual on Codes (WMO No. 306).
 		CLEAR_AND_DRY,
 		DAMP,
 		WET_AND_WATER_PATCHES,
@@ -1517,7 +1696,7 @@ public:
 		NOT_REPORTED
 	};
 
-	enum class Extent {// Extent of runway contamination, see Table 0519 in Manual on Codes (WMO No. 306).
+	enum class Extent : uint8_t {// Extent of runway contamination, see Table 0519 in Manual on Codes (WMO No. 306).
 		NONE,
 		LESS_THAN_10_PERCENT,
 		FROM_11_TO_25_PERCENT,
@@ -1547,10 +1726,10 @@ public:
 
 	RunwayStateGroup() = default;
 	static inline std::optional<RunwayStateGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1565,9 +1744,10 @@ private:
 	RunwayStateGroup(Type t, Runway r, SurfaceFriction s = SurfaceFriction()) :
 		rw(r), tp(t), sf(s) {}
 
-	static inline std::optional<Deposits> depositsFromString(const std::string & s);
-	static inline std::optional<Extent> extentFromString(const std::string & s);
+	static inline std::optional<Deposits> depositsFromString(std::string_view s);
+	static inline std::optional<Extent> extentFromString(std::string_view s);
 };
+static_assert(sizeof(RunwayStateGroup) <= 20, "RunwayStateGroup exceeds its size budget");
 
 class SeaSurfaceGroup {
 public:
@@ -1577,10 +1757,10 @@ public:
 
 	SeaSurfaceGroup() = default;
 	static inline std::optional<SeaSurfaceGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1588,10 +1768,11 @@ private:
 	Temperature t;
 	WaveHeight wh;
 };
+static_assert(sizeof(SeaSurfaceGroup) <= 8, "SeaSurfaceGroup exceeds its size budget");
 
 class MinMaxTemperatureGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		OBSERVED_6_HOURLY,
 		OBSERVED_24_HOURLY,
 		FORECAST
@@ -1605,10 +1786,10 @@ public:
 
 	MinMaxTemperatureGroup() = default;
 	static inline std::optional<MinMaxTemperatureGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
@@ -1620,19 +1801,20 @@ private:
 	bool isIncomplete = false;
 
 	static inline std::optional<MinMaxTemperatureGroup> from6hourly(
-		const std::string & group);
+		std::string_view group);
 	static inline std::optional<MinMaxTemperatureGroup> from24hourly(
-		const std::string & group);
+		std::string_view group);
 	static inline std::optional<MinMaxTemperatureGroup> fromForecast(
-		const std::string & group);
+		std::string_view group);
 
-	inline AppendResult append6hourly(const std::string & group);
-	inline AppendResult appendForecast(const std::string & group);
+	inline AppendResult append6hourly(std::string_view group);
+	inline AppendResult appendForecast(std::string_view group);
 };
+static_assert(sizeof(MinMaxTemperatureGroup) <= 20, "MinMaxTemperatureGroup exceeds its size budget");
 
 class PrecipitationGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		TOTAL_PRECIPITATION_HOURLY,
 		SNOW_DEPTH_ON_GROUND,
 		FROZEN_PRECIP_3_OR_6_HOURLY,
@@ -1658,10 +1840,10 @@ public:
 	bool isValid() const { return !isIncomplete; }
 
 	PrecipitationGroup() = default;
-	static inline std::optional<PrecipitationGroup> parse(const std::string & group,
+	static inline std::optional<PrecipitationGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
@@ -1674,10 +1856,11 @@ private:
 	static inline float factorFromType(Type type);
 	static inline Precipitation::Unit unitFromType(Type type);
 };
+static_assert(sizeof(PrecipitationGroup) <= 24, "PrecipitationGroup exceeds its size budget");
 
 class LayerForecastGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		ICING_TRACE_OR_NONE,
 		ICING_LIGHT_MIXED,
 		ICING_LIGHT_RIME_IN_CLOUD,
@@ -1706,10 +1889,10 @@ public:
 	bool isValid() const { return true; }
 
 	LayerForecastGroup() = default;
-	static inline std::optional<LayerForecastGroup> parse(const std::string & group,
+	static inline std::optional<LayerForecastGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1718,12 +1901,13 @@ private:
 	Distance layerBaseHeight;
 	Distance layerTopHeight;
 
-	static inline std::optional<Type> typeFromStr(const std::string & s);
+	static inline std::optional<Type> typeFromStr(std::string_view s);
 };
+static_assert(sizeof(LayerForecastGroup) <= 20, "LayerForecastGroup exceeds its size budget");
 
 class PressureTendencyGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		NOT_REPORTED,
 		INCREASING_THEN_DECREASING,
 		INCREASING_MORE_SLOWLY,
@@ -1737,7 +1921,7 @@ public:
 		RISING_RAPIDLY,
 		FALLING_RAPIDLY
 	};
-	enum class Trend {
+	enum class Trend : uint8_t {
 		NOT_REPORTED,
 		HIGHER,
 		HIGHER_OR_SAME,
@@ -1752,10 +1936,10 @@ public:
 
 	PressureTendencyGroup() = default;
 	static inline std::optional<PressureTendencyGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1765,6 +1949,7 @@ private:
 
 	static inline std::optional<Type> typeFromChar(char type);
 };
+static_assert(sizeof(PressureTendencyGroup) <= 12, "PressureTendencyGroup exceeds its size budget");
 
 class CloudTypesGroup {
 public:
@@ -1772,22 +1957,22 @@ public:
 	inline bool isValid() const;
 
 	CloudTypesGroup() = default;
-	static inline std::optional<CloudTypesGroup> parse(const std::string & group,
+	static inline std::optional<CloudTypesGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
 private:
-	size_t cldTpSize = 0;
 	inline static const size_t cldTpMaxSize = 8;
-	CloudType cldTp[cldTpMaxSize];
+	CompactList<CloudType, 3> cldTp;
 };
+static_assert(sizeof(CloudTypesGroup) <= 48, "CloudTypesGroup exceeds its size budget");
 
 class LowMidHighCloudGroup {
 public:
-	enum class LowLayer {
+	enum class LowLayer : uint8_t {
 		NONE,
 		CU_HU_CU_FR,
 		CU_MED_CU_CON,
@@ -1800,7 +1985,7 @@ public:
 		CB_CAP,
 		NOT_OBSERVABLE
 	};
-	enum class MidLayer {
+	enum class MidLayer : uint8_t {
 		NONE,
 		AS_TR,
 		AS_OP_NS,
@@ -1813,7 +1998,7 @@ public:
 		AC_OF_CHAOTIC_SKY,
 		NOT_OBSERVABLE
 	};
-	enum class HighLayer {
+	enum class HighLayer : uint8_t {
 		NONE,
 		CI_FIB_CI_UNC,
 		CI_SPI_CI_CAS_CI_FLO,
@@ -1832,10 +2017,10 @@ public:
 	inline bool isValid() const;
 
 	LowMidHighCloudGroup() = default;
-	static inline std::optional<LowMidHighCloudGroup> parse(const std::string & group,
+	static inline std::optional<LowMidHighCloudGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1848,10 +2033,11 @@ private:
 	static inline MidLayer midLayerFromChar(char c);
 	static inline HighLayer highLayerFromChar(char c);
 };
+static_assert(sizeof(LowMidHighCloudGroup) <= 3, "LowMidHighCloudGroup exceeds its size budget");
 
 class LightningGroup {
 public:
-	enum class Frequency {
+	enum class Frequency : uint8_t {
 		NONE,			// Not specified
 		OCCASIONAL,		// Less than 1 flash/minute
 		FREQUENT,		// 1 to 6 flashes/minute
@@ -1868,10 +2054,10 @@ public:
 	inline bool isValid() const { return !typeUnknown; }
 
 	LightningGroup() = default;
-	static inline std::optional<LightningGroup> parse(const std::string & group,
+	static inline std::optional<LightningGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	inline AppendResult append(const std::string & group,
+	inline AppendResult append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1894,15 +2080,16 @@ private:
 		incomplete = true;
 	}
 	static inline std::optional<LightningGroup> fromLtgGroup(
-		const std::string & group);
+		std::string_view group);
 	bool isOmittedDir1() const { return (!dir1from.has_value() && !dir1to.has_value()); }
 	bool isOmittedDir2() const { return (!dir2from.has_value() && !dir2to.has_value()); }
 };
+static_assert(sizeof(LightningGroup) <= 44, "LightningGroup exceeds its size budget");
 
 class VicinityGroup {
 public:
 	VicinityGroup() = default;
-	enum class Type {
+	enum class Type : uint8_t {
 		THUNDERSTORM,
 		CUMULONIMBUS,
 		CUMULONIMBUS_MAMMATUS,
@@ -1931,10 +2118,10 @@ public:
 		return (incompleteType == IncompleteType::NONE);
 	}
 
-	static inline std::optional<VicinityGroup> parse(const std::string & group,
+	static inline std::optional<VicinityGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	inline AppendResult append(const std::string & group,
+	inline AppendResult append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1947,7 +2134,7 @@ private:
 	std::optional<Direction> dir2to;
 	Direction movDir;
 
-	enum class IncompleteType {
+	enum class IncompleteType : uint8_t {
 		NONE,				// Group complete
 		EXPECT_CLD, 		// ROTOR previously specified, now expecting CLD
 		EXPECT_DIST_DIR1,	// Expect distance or first direction sector
@@ -1975,14 +2162,15 @@ private:
 		if (type() == Type::ROTOR_CLOUD) incompleteType = IncompleteType::EXPECT_CLD;
 	}
 
-	inline bool appendDir1(const std::string & str);
-	inline bool appendDir2(const std::string & str);
-	inline bool appendDistance(const std::string & str);
+	inline bool appendDir1(std::string_view str);
+	inline bool appendDir2(std::string_view str);
+	inline bool appendDistance(std::string_view str);
 };
+static_assert(sizeof(VicinityGroup) <= 44, "VicinityGroup exceeds its size budget");
 
 class MiscGroup {
 public:
-	enum class Type {
+	enum class Type : uint8_t {
 		SUNSHINE_DURATION_MINUTES,
 		CORRECTED_WEATHER_OBSERVATION,
 		DENSITY_ALTITUDE,
@@ -2014,15 +2202,15 @@ public:
 	inline bool isValid() const;
 
 	MiscGroup() = default;
-	static inline std::optional<MiscGroup> parse(const std::string & group,
+	static inline std::optional<MiscGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
 private:
-	enum class IncompleteText {
+	enum class IncompleteText : uint8_t {
 		NONE,
 		DENSITY,
 		DENSITY_ALT,
@@ -2034,22 +2222,23 @@ private:
 	std::optional<float> groupData;
 	IncompleteText incompleteText = IncompleteText::NONE;
 
-	inline static std::optional<Type> parseColourCode(const std::string & group);
-	inline bool appendHailstoneFraction (const std::string & group);
-	inline bool appendDensityAltitude (const std::string & group);
+	inline static std::optional<Type> parseColourCode(std::string_view group);
+	inline bool appendHailstoneFraction (std::string_view group);
+	inline bool appendDensityAltitude (std::string_view group);
 };
+static_assert(sizeof(MiscGroup) <= 16, "MiscGroup exceeds its size budget");
 
 class UnknownGroup {
 public:
 	UnknownGroup() = default;
-	static std::optional<UnknownGroup> parse(const std::string & group,
+	static std::optional<UnknownGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata)
 	{
 		(void)group; (void)reportPart; (void)reportMetadata;
 		return UnknownGroup();
 	}
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata)
 	{
@@ -2058,21 +2247,77 @@ public:
 	}
 	bool isValid() const { return true; }
 };
+static_assert(sizeof(UnknownGroup) <= 1, "UnknownGroup exceeds its size budget");
+
+// Keep Group within a single cache line so that ParseResult::groups stays
+// compact; each group type also has its own size budget (stated after the
+// class) so that the type which grew is pointed at
+static_assert(sizeof(Group) <= 64, "Group exceeds its size budget");
 
 ///////////////////////////////////////////////////////////////////////////////
 
-struct GroupInfo {
-	GroupInfo(Group g, ReportPart rp, std::string rawstr) :
+// Position of a group's raw string in the report it was parsed from; a group
+// made of several report groups spans the delimiters between them
+struct ReportSpan {
+	uint32_t offset = 0;
+	uint32_t length = 0;
+	bool empty() const { return !length; }
+	// Report text as is, including original delimiters
+	std::string_view view(std::string_view report) const {
+		return report.substr(offset, length);
+	}
+	// Raw string as stored by GroupInfo: report groups within the span
+	// joined by groupDelimiterChar
+	inline std::string toString(std::string_view report) const;
+	// Appends report groups in text joined by groupDelimiterChar
+	static inline void joinGroups(std::string_view text, std::string & output);
+};
+
+// Used in place of an allocator with BasicGroupInfo, BasicParseResult and
+// BasicParserContext to avoid copying raw strings: groups keep ReportSpan
+// instead, so the caller must keep the report alive while the result is used
+struct ReportSpans {};
+
+// Type of GroupInfo raw strings and allocator of containers in parse result
+// and parser context
+template <typename Allocator>
+struct RawStringTraits {
+	using String = std::basic_string<char, std::char_traits<char>, Allocator>;
+	using ContainerAllocator = Allocator;
+	static ContainerAllocator containerAllocator(const Allocator & a) { return a; }
+};
+
+template <>
+struct RawStringTraits<ReportSpans> {
+	using String = ReportSpan;
+	using ContainerAllocator = std::allocator<char>;
+	static ContainerAllocator containerAllocator(const ReportSpans &) {
+		return ContainerAllocator();
+	}
+};
+
+// Group with its report part and raw string; Allocator is used for the raw
+// string (e.g. std::pmr::polymorphic_allocator to parse into an arena) or is
+// ReportSpans to keep the raw string's span in the report instead
+// G is the group variant; a variant with only some of the alternatives of
+// Group may be used to build a trimmed parser (see BasicGroupParser)
+template <typename Allocator, typename G = Group>
+struct BasicGroupInfo {
+	using Group = G;
+	using String = typename RawStringTraits<Allocator>::String;
+	BasicGroupInfo(Group g, ReportPart rp, String rawstr) :
 		group(std::move(g)), reportPart(rp), rawString(std::move(rawstr)) {}
 	Group group;
 	ReportPart reportPart;
-	std::string rawString;
+	String rawString;
 };
 
+using GroupInfo = BasicGroupInfo<std::allocator<char>>;
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // Syntax Group is a delimiter of structural part of METAR/TAF report
-enum class SyntaxGroup {
+enum class SyntaxGroup : uint8_t {
 	OTHER,			// Group is not important for report syntax
 	METAR,			// Keyword METAR (beginning of METAR report)
 	SPECI,			// Keyword SPECI (beginning of METAR report)
@@ -2089,121 +2334,451 @@ enum class SyntaxGroup {
 };
 
 // Determines groups important for report syntax
-inline SyntaxGroup getSyntaxGroup(const Group & group);
+template <typename G>
+inline SyntaxGroup getSyntaxGroup(const G & group);
 
 ///////////////////////////////////////////////////////////////////////////////
 
-class GroupParser {
+// Parses a single group into group variant G; G must have KeywordGroup,
+// LocationGroup, ReportTimeGroup, TrendGroup (which determine report syntax)
+// and FallbackGroup among its alternatives, other alternatives of Group may
+// be omitted, e.g. std::variant<KeywordGroup, LocationGroup,
+// ReportTimeGroup, TrendGroup, WindGroup, PressureGroup, FallbackGroup>
+// Omitted alternatives are never tried and their groups become
+// FallbackGroup, same as with ParseOptions::decodedTypes
+template <typename G>
+class BasicGroupParser {
+	static_assert(isGroupAlternative<KeywordGroup, G>() &&
+		isGroupAlternative<LocationGroup, G>() &&
+		isGroupAlternative<ReportTimeGroup, G>() &&
+		isGroupAlternative<TrendGroup, G>() &&
+		isGroupAlternative<FallbackGroup, G>(),
+		"Group variant lacks groups required by the parser");
 public:
-	static Group parse(const std::string & group,
+	// Only the alternatives in decodedTypes are tried, a group not
+	// recognised by any of them is FallbackGroup
+	static G parse(std::string_view group,
 		ReportPart reportPart,
-		const ReportMetadata & reportMetadata)
+		const ReportMetadata & reportMetadata,
+		GroupTypeMask decodedTypes = allGroupTypes)
 	{
-		return parseAlternative<0>(group, reportPart, reportMetadata);
+		return parseAlternative<0>(group,
+			reportPart,
+			reportMetadata,
+			candidates(group, reportPart) & decodedTypes);
 	}
 
-	static Group reparse(const std::string & group,
+	// Alternative of previous and alternatives in rejectedTypes are known
+	// not to recognise the group and are not tried
+	static G reparse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata,
-		const Group & previous)
+		const G & previous,
+		GroupTypeMask decodedTypes = allGroupTypes,
+		GroupTypeMask rejectedTypes = GroupTypeMask())
 	{
-		return reparseAlternative<0>(group, reportPart, reportMetadata, previous.index());
+		return reparseAlternative<0>(group,
+			reportPart,
+			reportMetadata,
+			previous.index(),
+			candidates(group, reportPart) & decodedTypes & ~rejectedTypes);
+	}
+
+	// Alternatives tried by parse() or reparse() before the alternative of
+	// their result; if the result is not FallbackGroup, these alternatives
+	// did not recognise the group
+	static GroupTypeMask typesBefore(const G & result) {
+		static constexpr auto table =
+			typesBeforeTable(std::make_index_sequence<std::variant_size_v<G>>());
+		return table[result.index()];
+	}
+
+	// Bit I is set if alternative I of Group may recognise the group; bits
+	// refer to Group alternatives even if G is a trimmed variant
+	using CandidateMask = GroupTypeMask;
+
+	// Chars which the groups recognised by the alternative may begin with,
+	// in the given report part; any char not listed rules the alternative out
+	struct CandidateShape {
+		size_t alternative;
+		ReportPart reportPart;
+		std::string_view firstChars;
+	};
+
+	// Alternatives which may recognise the group in the report part, looked
+	// up by the first char of the group; the table below must list every
+	// char which parse() of an alternative accepts at the beginning of a
+	// group, which is checked by test/candidates.cpp
+	static CandidateMask candidates(std::string_view group, ReportPart reportPart) {
+		static const auto reportPartCount = static_cast<size_t>(ReportPart::RMK) + 1;
+		static const auto charCount = 256u;
+		static const auto table = [] {
+			static const std::string_view digits = "0123456789";
+			static const std::string_view letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+			static const CandidateShape shapes[] = {
+				{alternativeIndex<KeywordGroup>(), ReportPart::UNKNOWN, "$"},
+				{alternativeIndex<KeywordGroup>(), ReportPart::HEADER, "MSTACN$"},
+				{alternativeIndex<KeywordGroup>(), ReportPart::METAR, "CNAR$"},
+				{alternativeIndex<KeywordGroup>(), ReportPart::TAF, "NCR$"},
+				{alternativeIndex<KeywordGroup>(), ReportPart::RMK, "AN$"},
+				{alternativeIndex<LocationGroup>(), ReportPart::HEADER, letters},
+				{alternativeIndex<ReportTimeGroup>(), ReportPart::HEADER, digits},
+				{alternativeIndex<TrendGroup>(), ReportPart::HEADER, digits},
+				{alternativeIndex<TrendGroup>(), ReportPart::METAR, digits},
+				{alternativeIndex<TrendGroup>(), ReportPart::METAR, "BTINFA"},
+				{alternativeIndex<TrendGroup>(), ReportPart::TAF, digits},
+				{alternativeIndex<TrendGroup>(), ReportPart::TAF, "BTIPF"},
+				{alternativeIndex<WindGroup>(), ReportPart::METAR, digits},
+				{alternativeIndex<WindGroup>(), ReportPart::METAR, "WV/"},
+				{alternativeIndex<WindGroup>(), ReportPart::TAF, digits},
+				{alternativeIndex<WindGroup>(), ReportPart::TAF, "WV/"},
+				{alternativeIndex<WindGroup>(), ReportPart::RMK, "WP"},
+				{alternativeIndex<VisibilityGroup>(), ReportPart::METAR, digits},
+				{alternativeIndex<VisibilityGroup>(), ReportPart::METAR, "MPR/"},
+				{alternativeIndex<VisibilityGroup>(), ReportPart::TAF, digits},
+				{alternativeIndex<VisibilityGroup>(), ReportPart::TAF, "MP/"},
+				{alternativeIndex<VisibilityGroup>(), ReportPart::RMK, "VSTR"},
+				{alternativeIndex<CloudGroup>(), ReportPart::METAR, "NCSFBOV/"},
+				{alternativeIndex<CloudGroup>(), ReportPart::TAF, "NCSFBOV/"},
+				{alternativeIndex<CloudGroup>(), ReportPart::RMK, "CBVFSO"},
+				{alternativeIndex<WeatherGroup>(), ReportPart::METAR, letters},
+				{alternativeIndex<WeatherGroup>(), ReportPart::METAR, "+-/"},
+				{alternativeIndex<WeatherGroup>(), ReportPart::TAF, letters},
+				{alternativeIndex<WeatherGroup>(), ReportPart::TAF, "+-"},
+				{alternativeIndex<WeatherGroup>(), ReportPart::RMK, letters},
+				{alternativeIndex<TemperatureGroup>(), ReportPart::METAR, digits},
+				{alternativeIndex<TemperatureGroup>(), ReportPart::METAR, "M/"},
+				{alternativeIndex<TemperatureGroup>(), ReportPart::RMK, "T"},
+				{alternativeIndex<PressureGroup>(), ReportPart::METAR, "AQ"},
+				{alternativeIndex<PressureGroup>(), ReportPart::TAF, "Q"},
+				{alternativeIndex<PressureGroup>(), ReportPart::RMK, "AQSP"},
+				{alternativeIndex<RunwayStateGroup>(), ReportPart::METAR, "RS"},
+				{alternativeIndex<SeaSurfaceGroup>(), ReportPart::METAR, "W"},
+				{alternativeIndex<MinMaxTemperatureGroup>(), ReportPart::TAF, "T"},
+				{alternativeIndex<MinMaxTemperatureGroup>(), ReportPart::RMK, "124"},
+				{alternativeIndex<PrecipitationGroup>(), ReportPart::METAR, "R"},
+				{alternativeIndex<PrecipitationGroup>(), ReportPart::RMK, "PFIS4679"},
+				{alternativeIndex<LayerForecastGroup>(), ReportPart::TAF, "56"},
+				{alternativeIndex<PressureTendencyGroup>(), ReportPart::RMK, "P5"},
+				{alternativeIndex<CloudTypesGroup>(), ReportPart::RMK, digits},
+				{alternativeIndex<CloudTypesGroup>(), ReportPart::RMK, letters},
+				{alternativeIndex<LowMidHighCloudGroup>(), ReportPart::RMK, "8"},
+				{alternativeIndex<LightningGroup>(), ReportPart::RMK, "OFCL"},
+				{alternativeIndex<VicinityGroup>(), ReportPart::RMK, "TCASRVFHBM"},
+				{alternativeIndex<MiscGroup>(), ReportPart::METAR, "BWGYARC"},
+				{alternativeIndex<MiscGroup>(), ReportPart::TAF, "F"},
+				{alternativeIndex<MiscGroup>(), ReportPart::RMK, "BWGYARD9F"}
+			};
+			std::array<CandidateMask, reportPartCount * charCount> result {};
+			for (const auto & s : shapes) {
+				const auto row = static_cast<size_t>(s.reportPart) * charCount;
+				for (const auto c : s.firstChars)
+					result[row + static_cast<unsigned char>(c)] |= (1u << s.alternative);
+			}
+			return result;
+		}();
+		if (group.empty()) return ~CandidateMask();
+		const auto row = static_cast<size_t>(reportPart) * charCount;
+		return table[row + static_cast<unsigned char>(group[0])];
 	}
+
 private:
+	// Element I is the mask of alternatives of G with indices below I
+	template <size_t... I>
+	static constexpr std::array<GroupTypeMask, sizeof...(I)>
+		typesBeforeTable(std::index_sequence<I...>)
+	{
+		const GroupTypeMask types[] = {
+			groupTypeMask<std::variant_alternative_t<I, G>>()...
+		};
+		std::array<GroupTypeMask, sizeof...(I)> table {};
+		for (size_t i = 1; i < table.size(); i++)
+			table[i] = table[i - 1] | types[i - 1];
+		return table;
+	}
+
 	template <size_t I>
-	static Group parseAlternative(const std::string & group,
+	static G parseAlternative(std::string_view group,
 		ReportPart reportPart,
-		const ReportMetadata & reportMetadata)
+		const ReportMetadata & reportMetadata,
+		CandidateMask candidateMask)
 	{
-		using Alternative = std::variant_alternative_t<I, Group>;
+		using Alternative = std::variant_alternative_t<I, G>;
+		static_assert(isGroupAlternative<Alternative, Group>(),
+			"Group variant has alternatives which are not in Group");
 		if constexpr (!std::is_same<Alternative, FallbackGroup>::value) {
-			const auto parsed = Alternative::parse(group, reportPart, reportMetadata);
-			if (parsed.has_value()) return *parsed;
+			if (candidateMask & (1u << alternativeIndex<Alternative>())) {
+				const auto parsed = Alternative::parse(group, reportPart, reportMetadata);
+				if (parsed.has_value()) return *parsed;
+			}
 		}
-		if constexpr (I >= (std::variant_size_v<Group> - 1)) {
+		if constexpr (I >= (std::variant_size_v<G> - 1)) {
 			return FallbackGroup();
 		} else {
-			return parseAlternative<I+1>(group, reportPart, reportMetadata);
+			return parseAlternative<I+1>(group, reportPart, reportMetadata, candidateMask);
 		}
 	}
 
 	template <size_t I>
-	static Group reparseAlternative(const std::string & group,
+	static G reparseAlternative(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata,
-		size_t ignoreIndex)
+		size_t ignoreIndex,
+		CandidateMask candidateMask)
 	{
-		using Alternative = std::variant_alternative_t<I, Group>;
+		using Alternative = std::variant_alternative_t<I, G>;
 		if constexpr (!std::is_same<Alternative, FallbackGroup>::value) {
-			if (I != ignoreIndex) {
+			if (I != ignoreIndex &&
+				(candidateMask & (1u << alternativeIndex<Alternative>())))
+			{
 				const auto parsed = Alternative::parse(group, reportPart, reportMetadata);
 				if (parsed.has_value()) return *parsed;
 			}
 		}
-		if constexpr (I >= (std::variant_size_v<Group> - 1)) {
+		if constexpr (I >= (std::variant_size_v<G> - 1)) {
 			return FallbackGroup();
 		} else {
-			return reparseAlternative<I+1>(group, reportPart, reportMetadata, ignoreIndex);
+			return reparseAlternative<I+1>(group,
+				reportPart,
+				reportMetadata,
+				ignoreIndex,
+				candidateMask);
 		}
 	}
 };
 
-struct ParseResult {
+using GroupParser = BasicGroupParser<Group>;
+
+template <typename Allocator, typename G = Group>
+struct BasicParseResult {
+	using GroupInfo = BasicGroupInfo<Allocator, G>;
+	using ContainerAllocator = typename RawStringTraits<Allocator>::ContainerAllocator;
+	using GroupList = std::vector<GroupInfo,
+		typename std::allocator_traits<ContainerAllocator>::template rebind_alloc<GroupInfo>>;
+	explicit BasicParseResult(const Allocator & allocator = Allocator()) :
+		groups(RawStringTraits<Allocator>::containerAllocator(allocator)) {}
 	ReportMetadata reportMetadata;
-	std::vector<GroupInfo> groups;
+	GroupList groups;
 };
 
-class Parser {
+using ParseResult = BasicParseResult<std::allocator<char>>;
+
+// Number of times the parser decoded group strings again
+struct ReparseCounters {
+	// Groups decoded as report header and then again as METAR report body
+	// once report type became known (METAR reports without time span)
+	size_t reportTypeReparses = 0;
+	// Groups decoded again because the next group invalidated them
+	size_t invalidatedReparses = 0;
+	// Invalidated reparses of a group string decoded on its own just before,
+	// where alternatives which already rejected it were not tried again
+	size_t cachedReparses = 0;
+};
+
+// Reusable storage for parsing many reports in a row: each parse clears the
+// result of the previous one but keeps the memory allocated by the group list
+// and raw strings, so that parsing similar reports does not allocate
+template <typename Allocator, typename G = Group>
+class BasicParserContext {
 public:
-	static inline ParseResult parse (const std::string & report, size_t groupLimit = 200);
+	using Result = BasicParseResult<Allocator, G>;
+	explicit BasicParserContext(const Allocator & a = Allocator()) :
+		allocator(a),
+		parseResult(a),
+		rawStringPool(RawStringTraits<Allocator>::containerAllocator(a)) {}
+	const Result & result() const { return parseResult; }
+	inline void reserve(size_t groupCount);
+	// Summed over all reports parsed with this context
+	const ReparseCounters & reparseCounters() const { return counters; }
+	void resetReparseCounters() { counters = ReparseCounters(); }
 
 private:
-	static inline bool appendToLastResultGroup(ParseResult & result,
-		const std::string & groupStr,
-		ReportPart reportPart,
-		const ReportMetadata & reportMetadata,
-		bool allowReparse = true);
-	static inline void addGroupToResult(ParseResult & result,
-		Group group,
-		ReportPart reportPart,
-		std::string groupString);
-	static inline void updateMetadata(const Group & group,
-		ReportMetadata & reportMetadata);
+	friend class Parser;
+	using String = typename Result::GroupInfo::String;
+	using ContainerAllocator = typename Result::ContainerAllocator;
+	static const inline bool isSpanMode = std::is_same<String, ReportSpan>::value;
+	inline void clear();
+	// Raw string of group string s, which must be a part of the report in
+	// span mode unless empty
+	inline String rawString(std::string_view s);
+	inline void appendRawString(String & s, std::string_view group);
+	// Raw string as parsed by the groups; in span mode report groups are
+	// joined into a buffer valid until the next call
+	inline std::string_view groupString(const String & s);
+	// Report text of raw string, which rawString() converts back to it
+	inline std::string_view sourceString(const String & s);
+	inline void recycle(String && s);
+
+	// Group string (within the report) last decoded on its own and
+	// alternatives known not to recognise it in the report part
+	struct DecodedGroup {
+		std::string_view group;
+		ReportPart reportPart = ReportPart::UNKNOWN;
+		GroupTypeMask rejectedTypes = GroupTypeMask();
+	};
+
+	Allocator allocator;
+	Result parseResult;
+	std::vector<String,
+		typename std::allocator_traits<ContainerAllocator>::template rebind_alloc<String>>
+		rawStringPool;
+	// Report being parsed and buffer for joined report groups (span mode)
+	std::string_view report;
+	std::string joinedGroups;
+	DecodedGroup lastDecoded;
+	// Steps taken to parse current report, see ParseOptions::maxSteps
+	size_t steps = 0;
+	ReparseCounters counters;
+};
 
+using ParserContext = BasicParserContext<std::allocator<char>>;
+
+// Parse results which allocate from a std::pmr::memory_resource; e.g. a batch
+// of reports may be parsed into a monotonic arena released with one reset
+namespace pmr {
+	using GroupInfo = BasicGroupInfo<std::pmr::polymorphic_allocator<char>>;
+	using ParseResult = BasicParseResult<std::pmr::polymorphic_allocator<char>>;
+	using ParserContext = BasicParserContext<std::pmr::polymorphic_allocator<char>>;
+} //namespace pmr
+
+// Parse results which keep spans in the report instead of raw strings, e.g.
+// SpanParserContext context; const auto & result = Parser::parse(report,
+// context); result.groups[0].rawString.toString(report);
+using SpanGroupInfo = BasicGroupInfo<ReportSpans>;
+using SpanParseResult = BasicParseResult<ReportSpans>;
+using SpanParserContext = BasicParserContext<ReportSpans>;
+
+// Options which allow the parser to skip work not needed by the caller
+struct ParseOptions {
+	// Group types which are fully decoded, e.g.
+	// groupTypeMask<WindGroup, PressureGroup>(); groups of other types are
+	// kept as FallbackGroup with their raw strings; KeywordGroup,
+	// LocationGroup, ReportTimeGroup and TrendGroup determine report syntax
+	// and are always decoded; correction number in report metadata is only
+	// set if MiscGroup is decoded
+	GroupTypeMask decodedTypes = allGroupTypes;
+	// If true, remarks are not decoded but kept as one FallbackGroup with
+	// raw string of all remark groups (one span in span mode); report
+	// metadata flags set by remarks (e.g. AO2 or maintenance indicator) are
+	// not set; remarks may be decoded later with Parser::parseRemarks; the
+	// syntax checker does not see remark groups, so report errors which they
+	// would cause (e.g. in TAF remarks) are only set by Parser::parseRemarks
+	bool skipRemarks = false;
+	// Limits of work done for one report, zero for no limit; if a limit is
+	// exceeded, parsing stops and report error is PARSE_LIMIT_EXCEEDED
+
+	// Reports longer than this are not parsed at all
+	size_t maxReportLength = 0;
+	// Each attempt to decode a group, to append it to the previous group or
+	// to reparse an invalidated group is one step; time of a step grows
+	// linearly with group length
+	size_t maxSteps = 0;
+	// Number of tokens is limited by groupLimit of Parser::parse instead;
+	// each token counts, including the ones appended to the previous group,
+	// and if the limit is reached report error is REPORT_TOO_LARGE
+};
 
-	class ReportInput {
-	public:
-		ReportInput(const std::string & s) : report(s) {}
-		friend ReportInput & operator >> (ReportInput & input, std::string & output) {
-			output = input.getNextGroup();
-			return input;
-		}
-	private:
-		inline std::string getNextGroup();
-		const std::string & report;
-		bool finished = false;
-		size_t pos = 0;
-	};
+// Result of Parser::validate
+struct ValidationResult {
+	ReportType type = ReportType::UNKNOWN;
+	ReportError error = ReportError::NONE;
+	// Offset in the report of the group which caused the error, or report
+	// length if the error was detected at the end of the report
+	size_t errorOffset = 0;
+};
 
+template <typename Derived, typename T>
+class StaticVisitor;
 
+class Parser {
+	friend struct ReportSpan;
+	template <typename Allocator, typename G>
+	friend class BasicGroupRange;
+public:
+	static inline ParseResult parse (std::string_view report, size_t groupLimit = 200);
+	static inline ParseResult parse (std::string_view report,
+		const ParseOptions & options,
+		size_t groupLimit = 200);
+	static inline pmr::ParseResult parse (std::string_view report,
+		std::pmr::polymorphic_allocator<char> allocator,
+		size_t groupLimit = 200);
+	template <typename Allocator, typename G>
+	static inline const BasicParseResult<Allocator, G> & parse (std::string_view report,
+		BasicParserContext<Allocator, G> & context,
+		size_t groupLimit = 200);
+	template <typename Allocator, typename G>
+	static inline const BasicParseResult<Allocator, G> & parse (std::string_view report,
+		BasicParserContext<Allocator, G> & context,
+		const ParseOptions & options,
+		size_t groupLimit = 200);
+	// Push parsing: callback is called with each group (GroupInfo) as soon as
+	// it is final, i.e. cannot be appended to or invalidated by the following
+	// groups; groups are passed in the same order as in ParseResult but only
+	// the last one or two groups are kept, so memory used does not grow with
+	// report length; report metadata is complete after the last group and
+	// is returned, e.g.
+	// Parser::parse(report, [](const GroupInfo & groupInfo){ ... });
+	template <typename Callback,
+		typename = std::enable_if_t<std::is_invocable_v<Callback, const GroupInfo &>>>
+	static inline ReportMetadata parse (std::string_view report,
+		Callback && callback,
+		const ParseOptions & options = ParseOptions(),
+		size_t groupLimit = 200);
+	template <typename Derived>
+	static inline ReportMetadata parse (std::string_view report,
+		StaticVisitor<Derived, void> & visitor,
+		const ParseOptions & options = ParseOptions(),
+		size_t groupLimit = 200);
+	template <typename Allocator, typename G, typename Derived>
+	static inline const ReportMetadata & parse (std::string_view report,
+		BasicParserContext<Allocator, G> & context,
+		StaticVisitor<Derived, void> & visitor,
+		const ParseOptions & options = ParseOptions(),
+		size_t groupLimit = 200);
+	// Push parsing which reuses context storage; groups passed to callback
+	// are removed from the context parse result
+	template <typename Allocator, typename G, typename Callback,
+		typename = std::enable_if_t<std::is_invocable_v<Callback,
+			const BasicGroupInfo<Allocator, G> &>>>
+	static inline const ReportMetadata & parse (std::string_view report,
+		BasicParserContext<Allocator, G> & context,
+		Callback && callback,
+		const ParseOptions & options = ParseOptions(),
+		size_t groupLimit = 200);
+	// Parses remarks skipped by ParseOptions::skipRemarks, given the raw
+	// string of remarks and metadata of the report; groups are the same as
+	// if remarks were decoded with the report, and report metadata is
+	// updated by remark groups; in span mode spans are within remarks
+	static inline ParseResult parseRemarks(std::string_view remarks,
+		const ReportMetadata & reportMetadata,
+		const ParseOptions & options = ParseOptions(),
+		size_t groupLimit = 200);
+	template <typename Allocator, typename G>
+	static inline const BasicParseResult<Allocator, G> & parseRemarks(
+		std::string_view remarks,
+		const ReportMetadata & reportMetadata,
+		BasicParserContext<Allocator, G> & context,
+		const ParseOptions & options = ParseOptions(),
+		size_t groupLimit = 200);
+	// Checks report syntax without decoding the groups which do not affect
+	// it (see ParseOptions::decodedTypes) and without allocating memory;
+	// report type and error are the same as in the result of parse()
+	static inline ValidationResult validate(std::string_view report,
+		size_t groupLimit = 200) noexcept;
+	// Parses only report header and first group of report body (which may
+	// be NIL, CNL or AUTO) and returns report metadata without decoding the
+	// rest of the report; the error is only detected in the parsed groups
+	// and flags reported later in the report (e.g. AO2 in remarks or
+	// maintenance indicator) are not set
+	static inline ReportMetadata parseMetadata(std::string_view report);
+
+	// Syntax checker of METAR and TAF reports: a state machine driven by the
+	// syntax group of each report group; transitions are looked up in a
+	// table generated at compile time, which may also be used on its own,
+	// e.g. to validate sequences of syntax groups or to reject junk input
 	class Status {
 	public:
-		Status() :
-			state(State::REPORT_TYPE_OR_LOCATION),
-			reportType(ReportType::UNKNOWN),
-			reportError(ReportError::NONE) {}
-		ReportType getReportType() { return reportType; }
-		ReportError getError() { return reportError; }
-		bool isError() { return (reportError != ReportError::NONE); }
-		inline ReportPart getReportPart();
-		inline void transition(SyntaxGroup group);
-		inline void finalTransition();
-		bool isReparseRequired() {
-			return (state == State::REPORT_BODY_BEGIN_METAR_REPEAT_PARSE);
-		}
-		void setError(ReportError e) { state = State::ERROR; reportError = e; }
-	private:
-		enum class State {
+		enum class State : uint8_t {
 			// States of state machine used to check syntax of METAR/TAF reports
 			REPORT_TYPE_OR_LOCATION,
 			CORRECTION,
@@ -2221,36 +2796,275 @@ private:
 			CNL,
 			ERROR
 		};
+		// State and report type after a transition; error is NONE unless
+		// the transition detects one (state is then ERROR)
+		struct Transition {
+			State state;
+			ReportType reportType;
+			ReportError reportError;
+			// Row of state and report type, see tableIndex()
+			uint8_t row;
+		};
+		static const inline size_t stateCount =
+			static_cast<size_t>(State::ERROR) + 1;
+		static const inline size_t reportTypeCount =
+			static_cast<size_t>(ReportType::TAF) + 1;
+		static const inline size_t syntaxGroupCount =
+			static_cast<size_t>(SyntaxGroup::MAINTENANCE_INDICATOR) + 1;
+		static const inline size_t rowCount = stateCount * reportTypeCount;
+		// Indexed by tableIndex()
+		using TransitionTable = std::array<Transition, rowCount * syntaxGroupCount>;
+
+		Status() : Status(State::REPORT_TYPE_OR_LOCATION, ReportType::UNKNOWN) {}
+		Status(State s, ReportType rt) :
+			state(s),
+			reportType(rt),
+			reportError(ReportError::NONE),
+			row(rowIndex(state, reportType)) {}
+		State getState() { return state; }
+		ReportType getReportType() { return reportType; }
+		ReportError getError() { return reportError; }
+		bool isError() { return (reportError != ReportError::NONE); }
+		inline ReportPart getReportPart();
+		inline void transition(SyntaxGroup group);
+		inline void finalTransition();
+		bool isReparseRequired() {
+			return (state == State::REPORT_BODY_BEGIN_METAR_REPEAT_PARSE);
+		}
+		inline bool isReportBodyStarted();
+		void setError(ReportError e) {
+			state = State::ERROR;
+			reportError = e;
+			row = rowIndex(state, reportType);
+		}
+
+		static constexpr Transition transitionFor(State state,
+			ReportType reportType,
+			SyntaxGroup group);
+		static inline const TransitionTable & transitionTable();
+		// Table is grouped by syntax group, so that the row stored in the
+		// previous transition only needs to be added to find the next one
+		static constexpr size_t rowIndex(State state, ReportType reportType) {
+			return (static_cast<size_t>(state) * reportTypeCount +
+				static_cast<size_t>(reportType));
+		}
+		static constexpr size_t tableIndex(State state,
+			ReportType reportType,
+			SyntaxGroup group)
+		{
+			return (static_cast<size_t>(group) * rowCount +
+				rowIndex(state, reportType));
+		}
 
-		void setState(State s) { state = s; }
-		void setReportType(ReportType rt) { reportType = rt; }
-
-		inline void transitionFromReportTypeOrLocation(SyntaxGroup group);
-		inline void transitionFromCorrecton(SyntaxGroup group);
-		inline void transitionFromReportTime(SyntaxGroup group);
-		inline void transitionFromTimeSpan(SyntaxGroup group);
-		inline void transitionFromReportBodyBeginMetar(SyntaxGroup group);
-		inline void transitionFromReportBodyMetar(SyntaxGroup group);
-		inline void transitionFromReportBodyBeginTaf(SyntaxGroup group);
-		inline void transitionFromReportBodyTaf(SyntaxGroup group);
+	private:
 		State state;
 		ReportType reportType;
 		ReportError reportError;
+		uint8_t row;
+	};
+
+private:
+	static const inline GroupTypeMask syntaxGroupTypes =
+		groupTypeMask<KeywordGroup, LocationGroup, ReportTimeGroup, TrendGroup>();
+
+	template <typename Allocator, typename G>
+	static inline bool appendToLastResultGroup(BasicParserContext<Allocator, G> & context,
+		std::string_view groupStr,
+		ReportPart reportPart,
+		const ReportMetadata & reportMetadata,
+		GroupTypeMask decodedTypes,
+		bool allowReparse = true);
+	template <typename Allocator, typename G>
+	static inline void addGroupToResult(BasicParserContext<Allocator, G> & context,
+		G group,
+		ReportPart reportPart,
+		std::string_view groupString);
+	template <typename G>
+	static inline void updateMetadata(const G & group,
+		ReportMetadata & reportMetadata);
+	template <typename Allocator, typename G, typename Callback>
+	static inline void passGroups(BasicParserContext<Allocator, G> & context,
+		size_t count,
+		Callback & callback);
+
+	template <typename Allocator, typename G>
+	class ParseState;
+
+	class ReportInput {
+	public:
+		ReportInput(std::string_view s) : report(s) {}
+		friend ReportInput & operator >> (ReportInput & input, std::string_view & output) {
+			output = input.getNextGroup();
+			return input;
+		}
+	private:
+		inline std::string_view getNextGroup();
+		std::string_view report;
+		bool finished = false;
+		size_t pos = 0;
+
+		// Report is scanned in blocks; for each block two bit masks are
+		// built, one marking delimiters (ASCII control codes and spaces)
+		// and one marking all chars which may end a group (delimiters,
+		// report end char and '+'); bit N corresponds to char N of block
+		struct BlockMasks {
+			uint64_t delimiters = 0;
+			uint64_t groupEnds = 0;
+		};
+		static const inline size_t blockSize = 64;
+		using ScanFunction = BlockMasks (*)(const char * block);
+	#ifdef METAF_SIMD_SSE2
+		static inline BlockMasks scanBlockSse2(const char * block);
+	#endif
+	#ifdef METAF_SIMD_AVX2
+		static inline BlockMasks scanBlockAvx2(const char * block);
+	#endif
+		static inline ScanFunction selectScanFunction();
+		inline void loadBlock(size_t start);
+		inline size_t findNonDelimiter(size_t from);
+		inline size_t findGroupEnd(size_t from);
+
+		ScanFunction scanBlock = selectScanFunction();
+		size_t blockStart = std::string_view::npos;
+		BlockMasks blockMasks;
+	};
+
+};
+
+// Groups of a report parsed on demand while iterating, e.g.
+// for (const auto & groupInfo : GroupRange(report)) { if (...) break; }
+// Groups are the same as in the result of Parser::parse; a group is passed
+// on once final, which is before the next group is decoded or at most two
+// groups later, so that parsing stops soon after iteration is stopped and
+// the rest of the report (e.g. remarks) is not decoded
+// Range is single-pass, refers to the report and may not be copied or moved
+template <typename Allocator, typename G = Group>
+class BasicGroupRange {
+public:
+	using GroupInfo = BasicGroupInfo<Allocator, G>;
+
+	class Iterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = GroupInfo;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const GroupInfo *;
+		using reference = const GroupInfo &;
+
+		Iterator() = default;
+		reference operator*() const { return range->state.firstGroup(); }
+		pointer operator->() const { return &range->state.firstGroup(); }
+		Iterator & operator++() {
+			if (!range->next()) range = nullptr;
+			return *this;
+		}
+		bool operator==(const Iterator & other) const {
+			return (range == other.range);
+		}
+		bool operator!=(const Iterator & other) const {
+			return (range != other.range);
+		}
+
+	private:
+		friend class BasicGroupRange;
+		explicit Iterator(BasicGroupRange * r) : range(r) {}
+		BasicGroupRange * range = nullptr;
 	};
+
+	explicit BasicGroupRange(std::string_view report,
+		const ParseOptions & options = ParseOptions(),
+		size_t groupLimit = 200,
+		const Allocator & allocator = Allocator()) :
+			ownContext(allocator),
+			state(report, *ownContext, options, groupLimit) {}
+	// Range which reuses context storage, e.g. when iterating many reports;
+	// context must outlive the range and is cleared by it
+	BasicGroupRange(std::string_view report,
+		BasicParserContext<Allocator, G> & context,
+		const ParseOptions & options = ParseOptions(),
+		size_t groupLimit = 200) :
+			state(report, context, options, groupLimit) {}
+	BasicGroupRange(const BasicGroupRange &) = delete;
+	BasicGroupRange & operator=(const BasicGroupRange &) = delete;
+
+	// Iteration continues from the current group if begin() is called again
+	inline Iterator begin();
+	Iterator end() { return Iterator(); }
+	// Metadata of the groups parsed so far, complete after the last group
+	const ReportMetadata & reportMetadata() const {
+		return state.getReportMetadata();
+	}
+
+private:
+	inline bool next();
+
+	std::optional<BasicParserContext<Allocator, G>> ownContext;
+	Parser::ParseState<Allocator, G> state;
+	bool started = false;
+	bool hasGroup = false;
 };
 
+using GroupRange = BasicGroupRange<std::allocator<char>>;
+using SpanGroupRange = BasicGroupRange<ReportSpans>;
+namespace pmr {
+	using GroupRange = BasicGroupRange<std::pmr::polymorphic_allocator<char>>;
+} //namespace pmr
+
 ///////////////////////////////////////////////////////////////////////////////
 
-template <typename T>
-class Visitor {
+// Visitor without virtual calls: Derived class has the same visit functions
+// as Visitor (visitKeywordGroup(), visitLocationGroup(), etc.) but not
+// virtual, so that they may be inlined; they must be accessible to
+// StaticVisitor, i.e. public or with StaticVisitor<Derived, T> as a friend
+// Group alternative is dispatched by a jump table indexed by the alternative
+// rather than by checking alternatives one by one
+// Group may be Group or a trimmed group variant (see BasicGroupParser)
+template <typename Derived, typename T>
+class StaticVisitor {
 public:
-	inline T visit(const Group & group,
+	template <typename... Groups>
+	inline T visit(const std::variant<Groups...> & group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const std::string & rawString = std::string());
-	inline T visit(const GroupInfo & groupInfo) {
-		return visit(groupInfo.group, groupInfo.reportPart, groupInfo.rawString);
+	// Raw strings which are not std::string (e.g. from pmr::ParseResult) are
+	// copied into one; span mode groups need the report to resolve the span
+	template <typename Allocator, typename G>
+	inline T visit(const BasicGroupInfo<Allocator, G> & groupInfo) {
+		using String = typename BasicGroupInfo<Allocator, G>::String;
+		static_assert(!std::is_same<String, ReportSpan>::value,
+			"Raw string is a span, pass the report to visit()");
+		if constexpr (std::is_same<String, std::string>::value) {
+			return visit(groupInfo.group, groupInfo.reportPart, groupInfo.rawString);
+		} else {
+			return visit(groupInfo.group,
+				groupInfo.reportPart,
+				std::string(groupInfo.rawString.data(), groupInfo.rawString.length()));
+		}
+	}
+	template <typename G>
+	inline T visit(const BasicGroupInfo<ReportSpans, G> & groupInfo,
+		std::string_view report)
+	{
+		return visit(groupInfo.group,
+			groupInfo.reportPart,
+			groupInfo.rawString.toString(report));
 	}
+private:
+	template <size_t I, typename... Groups>
+	inline T visitIndex(const std::variant<Groups...> & group,
+		ReportPart reportPart,
+		const std::string & rawString);
+	template <typename Alternative>
+	inline T visitAlternative(const Alternative & group,
+		ReportPart reportPart,
+		const std::string & rawString);
+};
+
+// Group may be Group or a trimmed group variant (see BasicGroupParser)
+template <typename T>
+class Visitor : public StaticVisitor<Visitor<T>, T> {
 protected:
+	friend class StaticVisitor<Visitor<T>, T>;
 	virtual T visitKeywordGroup(
 		const KeywordGroup & group,
 		ReportPart reportPart,
@@ -2320,188 +3134,149 @@ protected:
 		const std::string & rawString) = 0;
 };
 
-template <typename T>
-inline T Visitor<T>::visit(const Group & group,
+template <typename Derived, typename T>
+template <typename... Groups>
+inline T StaticVisitor<Derived, T>::visit(const std::variant<Groups...> & group,
 	ReportPart reportPart,
 	const std::string & rawString)
 {
-	if (const auto gr = std::get_if<KeywordGroup>(&group); gr) {
-		return this->visitKeywordGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<LocationGroup>(&group); gr) {
-		return this->visitLocationGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<ReportTimeGroup>(&group); gr) {
-		return this->visitReportTimeGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<TrendGroup>(&group); gr) {
-		return this->visitTrendGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<WindGroup>(&group); gr) {
-		return this->visitWindGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<VisibilityGroup>(&group); gr) {
-		return this->visitVisibilityGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<CloudGroup>(&group); gr) {
-		return this->visitCloudGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<WeatherGroup>(&group); gr) {
-		return this->visitWeatherGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<TemperatureGroup>(&group); gr) {
-		return this->visitTemperatureGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<PressureGroup>(&group); gr) {
-		return this->visitPressureGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<RunwayStateGroup>(&group); gr) {
-		return this->visitRunwayStateGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<SeaSurfaceGroup>(&group); gr) {
-		return this->visitSeaSurfaceGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<MinMaxTemperatureGroup>(&group); gr) {
-		return this->visitMinMaxTemperatureGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<PrecipitationGroup>(&group); gr) {
-		return this->visitPrecipitationGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<LayerForecastGroup>(&group); gr) {
-		return this->visitLayerForecastGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<PressureTendencyGroup>(&group); gr) {
-		return this->visitPressureTendencyGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<CloudTypesGroup>(&group); gr) {
-		return this->visitCloudTypesGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<LowMidHighCloudGroup>(&group); gr) {
-		return this->visitLowMidHighCloudGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<LightningGroup>(&group); gr) {
-		return this->visitLightningGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<VicinityGroup>(&group); gr) {
-		return this->visitVicinityGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<MiscGroup>(&group); gr) {
-		return this->visitMiscGroup(*gr, reportPart, rawString);
-	}
-	if (const auto gr = std::get_if<UnknownGroup>(&group); gr) {
-		return this->visitUnknownGroup(*gr, reportPart, rawString);
+	// Switch on alternative index compiles to a jump table (std::visit was
+	// found to be several times slower); cases beyond the alternatives of a
+	// trimmed group variant are never taken
+	static_assert(sizeof...(Groups) <= std::variant_size_v<Group>,
+		"Group variant has alternatives which are not in Group");
+	static_assert(std::variant_size_v<Group> == 22,
+		"Group alternatives added or removed, update the switch below");
+	switch (group.index()) {
+		case 0: return visitIndex<0>(group, reportPart, rawString);
+		case 1: return visitIndex<1>(group, reportPart, rawString);
+		case 2: return visitIndex<2>(group, reportPart, rawString);
+		case 3: return visitIndex<3>(group, reportPart, rawString);
+		case 4: return visitIndex<4>(group, reportPart, rawString);
+		case 5: return visitIndex<5>(group, reportPart, rawString);
+		case 6: return visitIndex<6>(group, reportPart, rawString);
+		case 7: return visitIndex<7>(group, reportPart, rawString);
+		case 8: return visitIndex<8>(group, reportPart, rawString);
+		case 9: return visitIndex<9>(group, reportPart, rawString);
+		case 10: return visitIndex<10>(group, reportPart, rawString);
+		case 11: return visitIndex<11>(group, reportPart, rawString);
+		case 12: return visitIndex<12>(group, reportPart, rawString);
+		case 13: return visitIndex<13>(group, reportPart, rawString);
+		case 14: return visitIndex<14>(group, reportPart, rawString);
+		case 15: return visitIndex<15>(group, reportPart, rawString);
+		case 16: return visitIndex<16>(group, reportPart, rawString);
+		case 17: return visitIndex<17>(group, reportPart, rawString);
+		case 18: return visitIndex<18>(group, reportPart, rawString);
+		case 19: return visitIndex<19>(group, reportPart, rawString);
+		case 20: return visitIndex<20>(group, reportPart, rawString);
+		case 21: return visitIndex<21>(group, reportPart, rawString);
+		default: return T();
+	}
+}
+
+template <typename Derived, typename T>
+template <size_t I, typename... Groups>
+inline T StaticVisitor<Derived, T>::visitIndex(const std::variant<Groups...> & group,
+	ReportPart reportPart,
+	const std::string & rawString)
+{
+	if constexpr (I < sizeof...(Groups)) {
+		return visitAlternative(*std::get_if<I>(&group), reportPart, rawString);
+	} else {
+		return T();
 	}
-	return T();
 }
 
-template<>
-inline void Visitor<void>::visit(const Group & group,
+template <typename Derived, typename T>
+template <typename Alternative>
+inline T StaticVisitor<Derived, T>::visitAlternative(const Alternative & group,
 	ReportPart reportPart,
 	const std::string & rawString)
 {
-	if (const auto gr = std::get_if<KeywordGroup>(&group); gr) {
-		this->visitKeywordGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<LocationGroup>(&group); gr) {
-		this->visitLocationGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<ReportTimeGroup>(&group); gr) {
-		this->visitReportTimeGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<TrendGroup>(&group); gr) {
-		this->visitTrendGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<WindGroup>(&group); gr) {
-		this->visitWindGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<VisibilityGroup>(&group); gr) {
-		this->visitVisibilityGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<CloudGroup>(&group); gr) {
-		this->visitCloudGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<WeatherGroup>(&group); gr) {
-		this->visitWeatherGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<TemperatureGroup>(&group); gr) {
-		this->visitTemperatureGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<PressureGroup>(&group); gr) {
-		this->visitPressureGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<RunwayStateGroup>(&group); gr) {
-		this->visitRunwayStateGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<SeaSurfaceGroup>(&group); gr) {
-		this->visitSeaSurfaceGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<MinMaxTemperatureGroup>(&group); gr) {
-		this->visitMinMaxTemperatureGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<PrecipitationGroup>(&group); gr) {
-		this->visitPrecipitationGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<LayerForecastGroup>(&group); gr) {
-		this->visitLayerForecastGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<PressureTendencyGroup>(&group); gr) {
-		this->visitPressureTendencyGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<CloudTypesGroup>(&group); gr) {
-		this->visitCloudTypesGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<LowMidHighCloudGroup>(&group); gr) {
-		this->visitLowMidHighCloudGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<LightningGroup>(&group); gr) {
-		this->visitLightningGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<VicinityGroup>(&group); gr) {
-		this->visitVicinityGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<MiscGroup>(&group); gr) {
-		this->visitMiscGroup(*gr, reportPart, rawString);
-		return;
-	}
-	if (const auto gr = std::get_if<UnknownGroup>(&group); gr) {
-		this->visitUnknownGroup(*gr, reportPart, rawString);
-		return;
+	auto & derived = static_cast<Derived &>(*this);
+	if constexpr (std::is_same<Alternative, KeywordGroup>::value) {
+		return derived.visitKeywordGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, LocationGroup>::value) {
+		return derived.visitLocationGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, ReportTimeGroup>::value) {
+		return derived.visitReportTimeGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, TrendGroup>::value) {
+		return derived.visitTrendGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, WindGroup>::value) {
+		return derived.visitWindGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, VisibilityGroup>::value) {
+		return derived.visitVisibilityGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, CloudGroup>::value) {
+		return derived.visitCloudGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, WeatherGroup>::value) {
+		return derived.visitWeatherGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, TemperatureGroup>::value) {
+		return derived.visitTemperatureGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, PressureGroup>::value) {
+		return derived.visitPressureGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, RunwayStateGroup>::value) {
+		return derived.visitRunwayStateGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, SeaSurfaceGroup>::value) {
+		return derived.visitSeaSurfaceGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, MinMaxTemperatureGroup>::value) {
+		return derived.visitMinMaxTemperatureGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, PrecipitationGroup>::value) {
+		return derived.visitPrecipitationGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, LayerForecastGroup>::value) {
+		return derived.visitLayerForecastGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, PressureTendencyGroup>::value) {
+		return derived.visitPressureTendencyGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, CloudTypesGroup>::value) {
+		return derived.visitCloudTypesGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, LowMidHighCloudGroup>::value) {
+		return derived.visitLowMidHighCloudGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, LightningGroup>::value) {
+		return derived.visitLightningGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, VicinityGroup>::value) {
+		return derived.visitVicinityGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, MiscGroup>::value) {
+		return derived.visitMiscGroup(group, reportPart, rawString);
+	} else if constexpr (std::is_same<Alternative, UnknownGroup>::value) {
+		return derived.visitUnknownGroup(group, reportPart, rawString);
+	} else {
+		return T();
 	}
 }
 
-template<>
-inline void Visitor<void>::visit(const GroupInfo & groupInfo) {
-	visit(groupInfo.group, groupInfo.reportPart, groupInfo.rawString);
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 
-inline std::optional<unsigned int> strToUint(const std::string & str,
+inline std::optional<unsigned int> strToUint(std::string_view str,
 	std::size_t startPos,
 	std::size_t digits);
 
+// Converts N consecutive 2-digit numbers, e.g. day, hour and minute in
+// DDHHMM format; fixed-width fields are validated and converted at once
+template <std::size_t N>
+inline std::optional<std::array<unsigned int, N> > strToUintPairs(
+	std::string_view str,
+	std::size_t startPos);
+
+inline bool isDigit(char c);
+
+inline bool isUpperLetter(char c);
+
+inline size_t countTrailingZeros(uint64_t value);
+
+// Packs a string of up to 7 chars and its length into an integer which may be
+// used as a case label, so that a string is matched against many keywords
+// with a single switch; longer strings are packed into zero which does not
+// match any keyword
+constexpr uint64_t packKey(std::string_view s) {
+	const auto maxLength = sizeof(uint64_t) - 1;
+	if (s.length() > maxLength) return 0;
+	auto result = static_cast<uint64_t>(s.length()) << (maxLength * 8);
+	for (auto i = 0u; i < s.length(); i++)
+		result |= static_cast<uint64_t>(static_cast<unsigned char>(s[i])) << (i * 8);
+	return result;
+}
+
 inline std::optional<std::pair<unsigned int, unsigned int> > fractionStrToUint(
-	const std::string & str,
+	std::string_view str,
 	std::size_t startPos,
 	std::size_t length);
 
@@ -2512,14 +3287,104 @@ inline std::optional<std::pair<unsigned int, unsigned int> > fractionStrToUint(
 
 namespace metaf {
 
-std::optional<unsigned int> strToUint(const std::string & str,
+bool isDigit(char c) {
+	return (c >= '0' && c <= '9');
+}
+
+bool isUpperLetter(char c) {
+	return (c >= 'A' && c <= 'Z');
+}
+
+size_t countTrailingZeros(uint64_t value) {
+	// Value must not be zero
+#if defined(__GNUC__)
+	return __builtin_ctzll(value);
+#else
+	size_t result = 0;
+	while (!(value & 1)) { value >>= 1; result++; }
+	return result;
+#endif
+}
+
+#ifdef METAF_SWAR
+// Loads size chars (1 to 8) into the last bytes of a 64-bit word without
+// reading past the chars; loads overlap if size is not a power of two
+inline uint64_t loadLastBytes(const char * data, std::size_t size) {
+	if (size >= sizeof(uint32_t)) {
+		uint32_t first, last;
+		std::memcpy(&first, data, sizeof(first));
+		std::memcpy(&last, data + size - sizeof(last), sizeof(last));
+		return (static_cast<uint64_t>(first) << ((sizeof(uint64_t) - size) * 8)) |
+			(static_cast<uint64_t>(last) << 32);
+	}
+	if (size >= sizeof(uint16_t)) {
+		uint16_t first, last;
+		std::memcpy(&first, data, sizeof(first));
+		std::memcpy(&last, data + size - sizeof(last), sizeof(last));
+		return (static_cast<uint64_t>(first) << ((sizeof(uint64_t) - size) * 8)) |
+			(static_cast<uint64_t>(last) << 48);
+	}
+	return static_cast<uint64_t>(static_cast<unsigned char>(data[0])) << 56;
+}
+
+// Loads a field of 1 to 8 digits which must be within str into the last
+// bytes of a 64-bit word (first digit in the lowest of them); each byte of
+// the result is the value of a digit and bytes in front of the field are
+// zero; returns nothing if the field has a non-digit char
+inline std::optional<uint64_t> loadDigits(std::string_view str,
+	std::size_t startPos,
+	std::size_t digits)
+{
+	// Chars loaded past the end of the field are shifted out
+	const auto end = startPos + digits;
+	uint64_t word;
+	if (str.length() >= sizeof(word)) {
+		const auto wordStart = (end >= sizeof(word)) ? end - sizeof(word) : 0;
+		std::memcpy(&word, str.data() + wordStart, sizeof(word));
+		word <<= (wordStart + sizeof(word) - end) * 8;
+	} else {
+		word = loadLastBytes(str.data(), str.length());
+		word <<= (str.length() - end) * 8;
+	}
+	// Chars in front of the field are replaced with '0'
+	static const uint64_t zeros = 0x3030303030303030u;
+	const auto paddingBits = (sizeof(word) - digits) * 8;
+	if (paddingBits) {
+		word &= ~uint64_t() << paddingBits;
+		word |= zeros >> (sizeof(word) * 8 - paddingBits);
+	}
+	// Each byte must be 0x30..0x39: high nibble is 3 and adding 6 does not
+	// carry into high nibble
+	static const uint64_t highNibbles = 0xF0F0F0F0F0F0F0F0u;
+	static const uint64_t sixes = 0x0606060606060606u;
+	static const uint64_t threes = 0x3333333333333333u;
+	if (((word & highNibbles) | (((word + sixes) & highNibbles) >> 4)) != threes)
+		return std::optional<uint64_t>();
+	return word & ~highNibbles;
+}
+#endif
+
+std::optional<unsigned int> strToUint(std::string_view str,
 	std::size_t startPos,
 	std::size_t digits)
 {
 	std::optional<unsigned int> error;
 	if (str.empty() || !digits || startPos + digits > str.length()) return error;
+#ifdef METAF_SWAR
+	// Fields of up to 4 digits are converted faster by the loop below
+	if (digits > 4 && digits <= sizeof(uint64_t)) {
+		auto word = loadDigits(str, startPos, digits);
+		if (!word.has_value()) return error;
+		// Adjacent digits are combined into 2-digit, 4-digit and finally
+		// 8-digit values
+		*word = (*word * ((uint64_t(10) << 8) + 1)) >> 8;
+		*word = ((*word & 0x00FF00FF00FF00FFu) * ((uint64_t(100) << 16) + 1)) >> 16;
+		return static_cast<unsigned int>(
+			((*word & 0x0000FFFF0000FFFFu) * ((uint64_t(10000) << 32) + 1)) >> 32);
+	}
+#endif
 	unsigned int value = 0;
-	for (auto [i,c] = std::pair(0u, str.c_str() + startPos); i < digits; i++, c++) {
+	for (auto [i,c] = std::pair(0u, str.data() + startPos); i < digits; i++, c++) {
 		if (*c < '0' || *c > '9') return error;
 		static const auto decimalRadix = 10u;
 		value = value * decimalRadix + (*c - '0');
@@ -2527,8 +3392,35 @@ std::optional<unsigned int> strToUint(const std::string & str,
 	return value;
 }
 
+template <std::size_t N>
+std::optional<std::array<unsigned int, N> > strToUintPairs(std::string_view str,
+	std::size_t startPos)
+{
+	static_assert(N && N <= sizeof(uint64_t) / 2, "Too many digit pairs");
+	std::optional<std::array<unsigned int, N> > error;
+	if (str.empty() || startPos + N * 2 > str.length()) return error;
+	std::array<unsigned int, N> result;
+#ifdef METAF_SWAR
+	auto word = loadDigits(str, startPos, N * 2);
+	if (!word.has_value()) return error;
+	// Each pair of digits is combined into its first byte
+	*word = (*word * ((uint64_t(10) << 8) + 1)) >> 8;
+	for (auto i = 0u; i < N; i++) {
+		const auto byte = sizeof(uint64_t) - N * 2 + i * 2;
+		result[i] = static_cast<unsigned int>((*word >> (byte * 8)) & 0xFF);
+	}
+#else
+	for (auto i = 0u; i < N; i++) {
+		const auto value = strToUint(str, startPos + i * 2, 2);
+		if (!value.has_value()) return error;
+		result[i] = *value;
+	}
+#endif
+	return result;
+}
+
 std::optional<std::pair<unsigned int, unsigned int> >
-	fractionStrToUint(const std::string & str,
+	fractionStrToUint(std::string_view str,
 		std::size_t startPos,
 		std::size_t length)
 {
@@ -2555,7 +3447,7 @@ std::optional<std::pair<unsigned int, unsigned int> >
 	return std::pair(*numerator, *denominator);
 }
 
-std::optional<Runway> Runway::fromString(const std::string & s, bool enableRwy) {
+std::optional<Runway> Runway::fromString(std::string_view s, bool enableRwy) {
 	//static const std::regex rgx("R(?:WY)?(\\d\\d)([RLC])?");
 	static const std::optional<Runway> error;
 	if (s.length() < 3) return error;
@@ -2618,42 +3510,38 @@ MetafTime::Date MetafTime::dateBeforeRef(const Date & refDate) const {
 	return result;
 }
 
-std::optional<MetafTime> MetafTime::fromStringDDHHMM(const std::string & s) {
+std::optional<MetafTime> MetafTime::fromStringDDHHMM(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d)?(\\d\\d)(\\d\\d)");
 	static const std::optional<MetafTime> error;
 	if (s.length() == 4) {
-		const auto hour = strToUint(s, 0, 2);
-		const auto minute = strToUint(s, 2, 2);
-		if (!hour.has_value() || !minute.has_value()) return error;
+		const auto hhmm = strToUintPairs<2>(s, 0);
+		if (!hhmm.has_value()) return error;
 		MetafTime metafTime;
-		metafTime.hourValue = *hour;
-		metafTime.minuteValue = *minute;
+		metafTime.hourValue = (*hhmm)[0];
+		metafTime.minuteValue = (*hhmm)[1];
 		return metafTime;
 	}
 	if (s.length() == 6) {
-		const auto day = strToUint(s, 0, 2);
-		const auto hour = strToUint(s, 2, 2);
-		const auto minute = strToUint(s, 4, 2);
-		if (!day.has_value() || !hour.has_value() || !minute.has_value()) return error;
+		const auto ddhhmm = strToUintPairs<3>(s, 0);
+		if (!ddhhmm.has_value()) return error;
 		MetafTime metafTime;
-		metafTime.dayValue = day;
-		metafTime.hourValue = *hour;
-		metafTime.minuteValue = *minute;
+		metafTime.dayValue = (*ddhhmm)[0];
+		metafTime.hourValue = (*ddhhmm)[1];
+		metafTime.minuteValue = (*ddhhmm)[2];
 		return metafTime;
 	}
 	return error;
 }
 
-std::optional<MetafTime> MetafTime::fromStringDDHH(const std::string & s) {
+std::optional<MetafTime> MetafTime::fromStringDDHH(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d)(\\d\\d)");
 	static const std::optional<MetafTime> error;
 	if (s.length() != 4) return error;
-	const auto day = strToUint(s, 0, 2);
-	const auto hour = strToUint(s, 2, 2);
-	if (!day.has_value() || !hour.has_value()) return error;
+	const auto ddhh = strToUintPairs<2>(s, 0);
+	if (!ddhh.has_value()) return error;
 	MetafTime metafTime;
-	metafTime.dayValue = day;
-	metafTime.hourValue = *hour;
+	metafTime.dayValue = (*ddhh)[0];
+	metafTime.hourValue = (*ddhh)[1];
 	return metafTime;
 }
 
@@ -2745,7 +3633,7 @@ Temperature Temperature::windChill(
 	return Temperature(windChillC);
 }
 
-std::optional<Temperature> Temperature::fromString(const std::string & s) {
+std::optional<Temperature> Temperature::fromString(std::string_view s) {
 	//static const std::regex rgx ("(?:(M)?(\\d\\d))|//");
 	std::optional<Temperature> error;
 	if (s == "//") return Temperature();
@@ -2768,7 +3656,7 @@ std::optional<Temperature> Temperature::fromString(const std::string & s) {
 	return error;
 }
 
-std::optional<Temperature> Temperature::fromRemarkString(const std::string & s) {
+std::optional<Temperature> Temperature::fromRemarkString(std::string_view s) {
 	//static const std::regex ("([01])(\\d\\d\\d)");
 	std::optional<Temperature> error;
 	if (s.length() != 4) return error;
@@ -2792,7 +3680,7 @@ std::optional<float> Temperature::toUnit(Unit unit) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<Speed> Speed::fromString(const std::string & s, Unit unit) {
+std::optional<Speed> Speed::fromString(std::string_view s, Unit unit) {
 	//static const std::regex rgx ("([1-9]?\\d\\d)|//");
 	static const std::optional<Speed> error;
 	if (s.empty() || s == "//") return Speed();
@@ -2817,7 +3705,7 @@ std::optional<float> Speed::toUnit(Unit unit) const {
 	}
 }
 
-std::optional<Speed::Unit> Speed::unitFromString(const std::string & s) {
+std::optional<Speed::Unit> Speed::unitFromString(std::string_view s) {
 	if (s == "KT") return Speed::Unit::KNOTS;
 	if (s == "MPS") return Speed::Unit::METERS_PER_SECOND;
 	if (s == "KMH") return Speed::Unit::KILOMETERS_PER_HOUR;
@@ -2866,7 +3754,7 @@ std::optional<float> Speed::mphToUnit(float valueMph, Unit otherUnit) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::optional<Distance> Distance::fromMeterString(const std::string & s) {
+std::optional<Distance> Distance::fromMeterString(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d\\d\\d)|////");
 	static const std::optional<Distance> error;
 	if (s.length() != 4) return error;
@@ -2878,14 +3766,14 @@ std::optional<Distance> Distance::fromMeterString(const std::string & s) {
 	if (!dist.has_value()) return error;
 	distance.dist = dist;
 
-	if (const auto valueMoreThan10km = 9999u; distance.dist == valueMoreThan10km) {
+	if (const auto valueMoreThan10km = 9999u; *distance.dist == valueMoreThan10km) {
 		distance.distModifier = Modifier::MORE_THAN;
 		distance.dist = 10000u;
 	}
 	return distance;
 }
 
-std::optional<Distance> Distance::fromMileString(const std::string & s,
+std::optional<Distance> Distance::fromMileString(std::string_view s,
 	bool remarkFormat)
 {
 	// static const std::regex rgx ("([PM])?(\\d?\\d)(?:/(\\d?\\d))?SM|////SM");
@@ -2945,7 +3833,7 @@ std::optional<Distance> Distance::fromMileString(const std::string & s,
 	return distance;
 }
 
-std::optional<Distance> Distance::fromHeightString(const std::string & s) {
+std::optional<Distance> Distance::fromHeightString(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d\\d)|///");
 	static const std::optional<Distance> error;
 	if (s.length() != 3) return error;
@@ -2958,7 +3846,7 @@ std::optional<Distance> Distance::fromHeightString(const std::string & s) {
 	return distance;
 }
 
-std::optional<Distance> Distance::fromRvrString(const std::string & s, bool unitFeet) {
+std::optional<Distance> Distance::fromRvrString(std::string_view s, bool unitFeet) {
 	//static const std::regex rgx ("([PM])?(\\d\\d\\d\\d)|////");
 	static const std::optional<Distance> error;
 	Distance distance;
@@ -2983,7 +3871,7 @@ std::optional<Distance> Distance::fromRvrString(const std::string & s, bool unit
 }
 
 std::optional<std::pair<Distance, Distance>> Distance::fromLayerString(
-	const std::string & s)
+	std::string_view s)
 {
 	//static const std::regex rgx ("(\\d\\d\\d)(\\d)");
 	static const std::optional<std::pair<Distance, Distance>> error;
@@ -3000,7 +3888,7 @@ std::optional<std::pair<Distance, Distance>> Distance::fromLayerString(
 	return std::pair(baseHeight, topHeight);
 }
 
-std::optional<Distance> Distance::fromKmString(const std::string & s) {
+std::optional<Distance> Distance::fromKmString(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d?)KM");
 	static const std::optional<Distance> error;
 	static const auto metersPerKm = 1000u;
@@ -3180,7 +4068,7 @@ Distance Distance::makeVicinity() {
 ////////////////////////////////////////////////////////////////////////////////
 
 std::optional<Direction> Direction::fromCardinalString(
-	const std::string & s,
+	std::string_view s,
 	bool enableOhdAlqds,
 	bool enableUnknown)
 {
@@ -3222,7 +4110,7 @@ std::optional<Direction> Direction::fromCardinalString(
 	return dir;
 }
 
-std::optional<Direction> Direction::fromDegreesString(const std::string & s) {
+std::optional<Direction> Direction::fromDegreesString(std::string_view s) {
 	std::optional<Direction> error;
 	Direction direction;
 	if (s.length() != 3) return error;
@@ -3274,17 +4162,36 @@ Direction::Cardinal Direction::cardinal(bool trueDirections) const {
 }
 
 std::optional<std::pair<Direction, Direction>> Direction::fromSectorString(
-	const std::string & s)
+	std::string_view s)
 {
 	static const std::optional<std::pair<Direction, Direction>> notRecognised;
-	static const std::regex rgx
-		("([NSWE][WE]?)(?:-[NSWE]|-[NS][WE])*-([NSWE][WE]?)");
-	static const auto matchBegin = 1, matchEnd = 2;
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return notRecognised;
-	const auto dirBegin = fromCardinalString(match.str(matchBegin));
+	//static const std::regex rgx
+	//	("([NSWE][WE]?)(?:-[NSWE]|-[NS][WE])*-([NSWE][WE]?)");
+	// Sector begin and end are [NSWE][WE]?, directions in between are
+	// [NSWE] or [NS][WE]
+	const auto isSectorDir = [](std::string_view d, bool intermediate) {
+		if (d.empty() || d.length() > 2) return false;
+		if (d[0] != 'N' && d[0] != 'S' && d[0] != 'W' && d[0] != 'E') return false;
+		if (d.length() == 1) return true;
+		if (intermediate && d[0] != 'N' && d[0] != 'S') return false;
+		return (d[1] == 'W' || d[1] == 'E');
+	};
+	const auto firstDelimiterPos = s.find('-');
+	if (firstDelimiterPos == std::string_view::npos) return notRecognised;
+	const auto lastDelimiterPos = s.rfind('-');
+	const auto beginStr = s.substr(0, firstDelimiterPos);
+	const auto endStr = s.substr(lastDelimiterPos + 1);
+	if (!isSectorDir(beginStr, false) || !isSectorDir(endStr, false))
+		return notRecognised;
+	for (auto pos = firstDelimiterPos; pos != lastDelimiterPos; ) {
+		const auto nextPos = s.find('-', pos + 1);
+		if (!isSectorDir(s.substr(pos + 1, nextPos - pos - 1), true))
+			return notRecognised;
+		pos = nextPos;
+	}
+	const auto dirBegin = fromCardinalString(beginStr);
 	if (!dirBegin.has_value()) return(notRecognised);
-	const auto dirEnd = fromCardinalString(match.str(matchEnd));
+	const auto dirEnd = fromCardinalString(endStr);
 	if (!dirEnd.has_value()) return(notRecognised);
 	return std::pair(*dirBegin, *dirEnd);
 }
@@ -3369,7 +4276,7 @@ Direction::Direction(Cardinal c) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<Pressure> Pressure::fromString(const std::string & s) {
+std::optional<Pressure> Pressure::fromString(std::string_view s) {
 	//static const std::regex rgx("([QA])(?:(\\d\\d\\d\\d)|////)");
 	static const std::optional<Pressure> error;
 	if (s.length() != 5) return error;
@@ -3398,7 +4305,7 @@ std::optional<Pressure> Pressure::fromString(const std::string & s) {
 	return pressure;
 }
 
-std::optional<Pressure> Pressure::fromForecastString(const std::string & s) {
+std::optional<Pressure> Pressure::fromForecastString(std::string_view s) {
 	//static const std::regex rgx("QNH(\\d\\d\\d\\d)INS");
 	static const std::optional<Pressure> error;
 	if (s.length() != 10) return error;
@@ -3412,7 +4319,7 @@ std::optional<Pressure> Pressure::fromForecastString(const std::string & s) {
 	return pressure;
 }
 
-std::optional<Pressure> Pressure::fromSlpString(const std::string & s) {
+std::optional<Pressure> Pressure::fromSlpString(std::string_view s) {
 	//SLP982 = 998.2 hPa, SLP015 = 1001.5 hPa, SLP221 = 1022.1 hPa
 	//static const std::regex rgx("SLP(\\d\\d\\d)");
 	static const std::optional<Pressure> error;
@@ -3428,7 +4335,7 @@ std::optional<Pressure> Pressure::fromSlpString(const std::string & s) {
 	return pressure;
 }
 
-std::optional<Pressure> Pressure::fromQfeString(const std::string & s) {
+std::optional<Pressure> Pressure::fromQfeString(std::string_view s) {
 	//static const std::regex rgx("QFE(\\d\\d\\d)(/\\d\\d\\d\\d)?");
 	static const std::optional<Pressure> error;
 	if (s.length() != 6 && s.length() != 11) return error;
@@ -3446,7 +4353,7 @@ std::optional<Pressure> Pressure::fromQfeString(const std::string & s) {
 	return pressure;
 }
 
-std::optional<Pressure> Pressure::fromTendencyString(const std::string & s) {
+std::optional<Pressure> Pressure::fromTendencyString(std::string_view s) {
 	//static const std::regex rgx("(\\d\\d\\d)|///");
 	static const std::optional<Pressure> error;
 	if (s.length() != 3) return error;
@@ -3491,7 +4398,7 @@ std::optional<float> Pressure::toUnit(Unit unit) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<Precipitation> Precipitation::fromRainfallString(const std::string & s) {
+std::optional<Precipitation> Precipitation::fromRainfallString(std::string_view s) {
 	//static const std::regex rgx("\\d?\\d\\d\\.\\d");
 	static const std::optional<Precipitation> error;
 	if (s == "///./" || s == "//./") return Precipitation();
@@ -3506,7 +4413,7 @@ std::optional<Precipitation> Precipitation::fromRainfallString(const std::string
 	return precipitation;
 }
 
-std::optional<Precipitation> Precipitation::fromRunwayDeposits(const std::string & s) {
+std::optional<Precipitation> Precipitation::fromRunwayDeposits(std::string_view s) {
 	//static const std::regex rgx("\\d\\d");
 	std::optional<Precipitation> error;
 	if (s.length() != 2) return error;
@@ -3537,7 +4444,7 @@ std::optional<Precipitation> Precipitation::fromRunwayDeposits(const std::string
 	return precipitation;
 }
 
-std::optional<Precipitation> Precipitation::fromRemarkString(const std::string & s,
+std::optional<Precipitation> Precipitation::fromRemarkString(std::string_view s,
 		float factor,
 		Precipitation::Unit unit,
 		bool allowNotReported)
@@ -3558,7 +4465,7 @@ std::optional<Precipitation> Precipitation::fromRemarkString(const std::string &
 }
 
 std::optional<std::pair<Precipitation, Precipitation>>
-	Precipitation::fromSnincrString(const std::string & s)
+	Precipitation::fromSnincrString(std::string_view s)
 {
 	//static const std::regex rgx("\\d?\\d)/(\\d?\\d");
 	static const std::optional<std::pair<Precipitation, Precipitation>> error;
@@ -3592,7 +4499,7 @@ std::optional<float> Precipitation::toUnit(Unit unit) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<SurfaceFriction> SurfaceFriction::fromString(const std::string & s) {
+std::optional<SurfaceFriction> SurfaceFriction::fromString(std::string_view s) {
 	//static const std::regex rgx("\\d\\d");
 	static const std::optional<SurfaceFriction> error;
 	if (s.length() != 2) return error;
@@ -3657,7 +4564,7 @@ SurfaceFriction::BrakingAction SurfaceFriction::brakingAction() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<WaveHeight> WaveHeight::fromString(const std::string & s) {
+std::optional<WaveHeight> WaveHeight::fromString(std::string_view s) {
 	//static const std::regex rgx("S(\\d)|H(\\d?\\d?\\d)");
 	static const std::optional<WaveHeight> error;
 	if (s.length() < 2 || s.length() > 4) return error;
@@ -3767,91 +4674,119 @@ WeatherPhenomena::Event WeatherPhenomena::event() const {
 	return static_cast<Event>((data >> eventShiftBits) & eventMask);
 }
 
-std::optional <WeatherPhenomena> WeatherPhenomena::fromString(const std::string & s,
+std::optional <WeatherPhenomena> WeatherPhenomena::fromString(std::string_view s,
 		bool enableQualifiers)
 {
-	// Descriptors MI, PR, BC are allowed only with FG
-	if (s == "MIFG") return WeatherPhenomena(Weather::FOG, Descriptor::SHALLOW);
-	if (s == "PRFG") return WeatherPhenomena(Weather::FOG, Descriptor::PARTIAL);
-	if (s == "BCFG") return WeatherPhenomena(Weather::FOG, Descriptor::PATCHES);
-	// Descriptor DR is allowed only with DU SA SN
-	if (s == "DRDU") return WeatherPhenomena(Weather::DUST, Descriptor::LOW_DRIFTING);
-	if (s == "DRSA") return WeatherPhenomena(Weather::SAND, Descriptor::LOW_DRIFTING);
-	if (s == "DRSN") return WeatherPhenomena(Weather::SNOW, Descriptor::LOW_DRIFTING);
-	// Descriptor BL is allowed only with DU SA SN PY
-	if (s == "BLDU") return WeatherPhenomena(Weather::DUST, Descriptor::BLOWING);
-	if (s == "BLSA") return WeatherPhenomena(Weather::SAND, Descriptor::BLOWING);
-	if (s == "BLSN") return WeatherPhenomena(Weather::SNOW, Descriptor::BLOWING);
-	if (s == "BLPY") return WeatherPhenomena(Weather::SPRAY, Descriptor::BLOWING);
-	// Descriptor TS is allowed alone (or with precipitation)
-	if (s == "TS") return WeatherPhenomena(Descriptor::THUNDERSTORM);
-	// Descriptor FZ is allowed only with FG (or with precipitation)
-	if (s == "FZFG") return WeatherPhenomena(Weather::FOG, Descriptor::FREEZING);
-	// Phenomena IC BR FG FU VA DU SA HZ PO SQ FC are allowed only when alone
-	// in the group, with no other phenomena present
-	if (s == "IC") return WeatherPhenomena(Weather::ICE_CRYSTALS);
-	if (s == "BR") return WeatherPhenomena(Weather::MIST);
-	if (s == "FG") return WeatherPhenomena(Weather::FOG);
-	if (s == "FU") return WeatherPhenomena(Weather::SMOKE);
-	if (s == "VA") return WeatherPhenomena(Weather::VOLCANIC_ASH);
-	if (s == "DU") return WeatherPhenomena(Weather::DUST);
-	if (s == "SA") return WeatherPhenomena(Weather::SAND);
-	if (s == "HZ") return WeatherPhenomena(Weather::HAZE);
-	if (s == "PO") return WeatherPhenomena(Weather::DUST_WHIRLS);
-	if (s == "SQ") return WeatherPhenomena(Weather::SQUALLS);
-	if (s == "FC") return WeatherPhenomena(Weather::FUNNEL_CLOUD);
-	// Phenomena SS DS are only allowed alone or in combination with each other
-	if (s == "DS") return WeatherPhenomena(Weather::DUSTSTORM);
-	if (s == "SS") return WeatherPhenomena(Weather::SANDSTORM);
-	if (s == "DSSS") return WeatherPhenomena(Weather::DUSTSTORM, Weather::SANDSTORM);
-	if (s == "SSDS") return WeatherPhenomena(Weather::SANDSTORM, Weather::DUSTSTORM);
+	const auto key = packKey(s);
+	switch (key) {
+		// Descriptors MI, PR, BC are allowed only with FG
+		case packKey("MIFG"):
+		return WeatherPhenomena(Weather::FOG, Descriptor::SHALLOW);
+		case packKey("PRFG"):
+		return WeatherPhenomena(Weather::FOG, Descriptor::PARTIAL);
+		case packKey("BCFG"):
+		return WeatherPhenomena(Weather::FOG, Descriptor::PATCHES);
+		// Descriptor DR is allowed only with DU SA SN
+		case packKey("DRDU"):
+		return WeatherPhenomena(Weather::DUST, Descriptor::LOW_DRIFTING);
+		case packKey("DRSA"):
+		return WeatherPhenomena(Weather::SAND, Descriptor::LOW_DRIFTING);
+		case packKey("DRSN"):
+		return WeatherPhenomena(Weather::SNOW, Descriptor::LOW_DRIFTING);
+		// Descriptor BL is allowed only with DU SA SN PY
+		case packKey("BLDU"):
+		return WeatherPhenomena(Weather::DUST, Descriptor::BLOWING);
+		case packKey("BLSA"):
+		return WeatherPhenomena(Weather::SAND, Descriptor::BLOWING);
+		case packKey("BLSN"):
+		return WeatherPhenomena(Weather::SNOW, Descriptor::BLOWING);
+		case packKey("BLPY"):
+		return WeatherPhenomena(Weather::SPRAY, Descriptor::BLOWING);
+		// Descriptor TS is allowed alone (or with precipitation)
+		case packKey("TS"):
+		return WeatherPhenomena(Descriptor::THUNDERSTORM);
+		// Descriptor FZ is allowed only with FG (or with precipitation)
+		case packKey("FZFG"):
+		return WeatherPhenomena(Weather::FOG, Descriptor::FREEZING);
+		// Phenomena IC BR FG FU VA DU SA HZ PO SQ FC are allowed only when
+		// alone in the group, with no other phenomena present
+		case packKey("IC"): return WeatherPhenomena(Weather::ICE_CRYSTALS);
+		case packKey("BR"): return WeatherPhenomena(Weather::MIST);
+		case packKey("FG"): return WeatherPhenomena(Weather::FOG);
+		case packKey("FU"): return WeatherPhenomena(Weather::SMOKE);
+		case packKey("VA"): return WeatherPhenomena(Weather::VOLCANIC_ASH);
+		case packKey("DU"): return WeatherPhenomena(Weather::DUST);
+		case packKey("SA"): return WeatherPhenomena(Weather::SAND);
+		case packKey("HZ"): return WeatherPhenomena(Weather::HAZE);
+		case packKey("PO"): return WeatherPhenomena(Weather::DUST_WHIRLS);
+		case packKey("SQ"): return WeatherPhenomena(Weather::SQUALLS);
+		case packKey("FC"): return WeatherPhenomena(Weather::FUNNEL_CLOUD);
+		// Phenomena SS DS are only allowed alone or in combination with each
+		// other
+		case packKey("DS"): return WeatherPhenomena(Weather::DUSTSTORM);
+		case packKey("SS"): return WeatherPhenomena(Weather::SANDSTORM);
+		case packKey("DSSS"):
+		return WeatherPhenomena(Weather::DUSTSTORM, Weather::SANDSTORM);
+		case packKey("SSDS"):
+		return WeatherPhenomena(Weather::SANDSTORM, Weather::DUSTSTORM);
+
+		default:
+		break;
+	}
 	if (enableQualifiers) {
-		// Qualifier VC is allowed only with VCTS VCFG VCSH VCPO VCFC VCVA VCBLDU
-		// VCBLSA VCBLSN VCDS VCSS
-		if (s == "VCTS")
+		switch (key) {
+			// Qualifier VC is allowed only with VCTS VCFG VCSH VCPO VCFC VCVA
+			// VCBLDU VCBLSA VCBLSN VCDS VCSS
+			case packKey("VCTS"):
 			return WeatherPhenomena(Descriptor::THUNDERSTORM, Qualifier::VICINITY);
-		if (s == "VCFG")
+			case packKey("VCFG"):
 			return WeatherPhenomena(Weather::FOG, Descriptor::NONE, Qualifier::VICINITY);
-		if (s == "VCSH")
+			case packKey("VCSH"):
 			return WeatherPhenomena(Descriptor::SHOWERS, Qualifier::VICINITY);
-		if (s == "VCPO")
+			case packKey("VCPO"):
 			return WeatherPhenomena(Weather::DUST_WHIRLS, Descriptor::NONE, Qualifier::VICINITY);
-		if (s == "VCVA")
+			case packKey("VCVA"):
 			return WeatherPhenomena(Weather::VOLCANIC_ASH, Descriptor::NONE, Qualifier::VICINITY);
-		if (s == "VCFC")
+			case packKey("VCFC"):
 			return WeatherPhenomena(Weather::FUNNEL_CLOUD, Descriptor::NONE, Qualifier::VICINITY);
-		if (s == "VCBLDU")
+			case packKey("VCBLDU"):
 			return WeatherPhenomena(Weather::DUST, Descriptor::BLOWING, Qualifier::VICINITY);
-		if (s == "VCBLSA")
+			case packKey("VCBLSA"):
 			return WeatherPhenomena(Weather::SAND, Descriptor::BLOWING, Qualifier::VICINITY);
-		if (s == "VCBLSN")
+			case packKey("VCBLSN"):
 			return WeatherPhenomena(Weather::SNOW, Descriptor::BLOWING, Qualifier::VICINITY);
-		if (s == "VCDS")
+			case packKey("VCDS"):
 			return WeatherPhenomena(Weather::DUSTSTORM, Descriptor::NONE, Qualifier::VICINITY);
-		if (s == "VCSS")
+			case packKey("VCSS"):
 			return WeatherPhenomena(Weather::SANDSTORM, Descriptor::NONE, Qualifier::VICINITY);
-		// Qualifier + are allowed with FC DS SS (or with precipitation)
-		if (s == "+FC")
+			// Qualifier + are allowed with FC DS SS (or with precipitation)
+			case packKey("+FC"):
 			return WeatherPhenomena(Weather::FUNNEL_CLOUD, Descriptor::NONE, Qualifier::HEAVY);
-		if (s == "+DS")
+			case packKey("+DS"):
 			return WeatherPhenomena(Weather::DUSTSTORM, Descriptor::NONE, Qualifier::HEAVY);
-		if (s == "+SS")
+			case packKey("+SS"):
 			return WeatherPhenomena(Weather::SANDSTORM, Descriptor::NONE, Qualifier::HEAVY);
-		if (s == "+DSSS")
+			case packKey("+DSSS"):
 			return WeatherPhenomena(Weather::DUSTSTORM, Weather::SANDSTORM,
 				Descriptor::NONE, Qualifier::HEAVY);
-		if (s == "+SSDS")
+			case packKey("+SSDS"):
 			return WeatherPhenomena(Weather::SANDSTORM, Weather::DUSTSTORM,
 				Descriptor::NONE, Qualifier::HEAVY);
-		// Qualifier RE is allowed with TS descriptor without any phenomena
-		if (s == "RETS")
+			// Qualifier RE is allowed with TS descriptor without any phenomena
+			case packKey("RETS"):
 			return WeatherPhenomena(Descriptor::THUNDERSTORM, Qualifier::RECENT);
+
+			default:
+			break;
+		}
 	}
 	// Precipitation
 	Qualifier resultQualifier = Qualifier::NONE;
 	Descriptor resultDescriptor = Descriptor::NONE;
-	std::vector<Weather> resultWeather;
-	std::string precipStr = s;
+	std::array<Weather, wSize> resultWeather;
+	resultWeather.fill(Weather::NOT_REPORTED);
+	size_t resultWeatherSize = 0;
+	std::string_view precipStr = s;
 	static const std::optional <WeatherPhenomena> error;
 	if (precipStr.length() < 2) return(error);
 	// Only + - RE qualifiers are allowed; no qualifier equals moderate intensity
@@ -3881,9 +4816,12 @@ std::optional <WeatherPhenomena> WeatherPhenomena::fromString(const std::string
 	}
 	// Descriptors SH TS and FZ are allowed
 	if (precipStr.length() < 2) return(error);
-	if (precipStr.substr(0, 2) == "SH") resultDescriptor = Descriptor::SHOWERS;
-	if (precipStr.substr(0, 2) == "TS") resultDescriptor = Descriptor::THUNDERSTORM;
-	if (precipStr.substr(0, 2) == "FZ") resultDescriptor = Descriptor::FREEZING;
+	switch (packKey(precipStr.substr(0, 2))) {
+		case packKey("SH"): resultDescriptor = Descriptor::SHOWERS; break;
+		case packKey("TS"): resultDescriptor = Descriptor::THUNDERSTORM; break;
+		case packKey("FZ"): resultDescriptor = Descriptor::FREEZING; break;
+		default: break;
+	}
 	if (resultDescriptor != Descriptor::NONE) precipStr = precipStr.substr(2);
 	// Phenomena DZ RA SN SG PL GR GS UP are allowed in any combinations if no
 	// duplicate phenomena is specified
@@ -3897,29 +4835,35 @@ std::optional <WeatherPhenomena> WeatherPhenomena::fromString(const std::string
 	bool allowFzDecriptor = false;
 	for (auto i = 0u; i < wSize; i++) {
 		if (precipStr.empty()) break;
-		const auto ws = precipStr.substr(0,2);
 		std::optional<Weather> w;
-		if (ws == "DZ") w = Weather::DRIZZLE;
-		if (ws == "RA") w = Weather::RAIN;
-		if (ws == "SN") w = Weather::SNOW;
-		if (ws == "SG") w = Weather::SNOW_GRAINS;
-		if (ws == "PL") w = Weather::ICE_PELLETS;
-		if (ws == "GR") w = Weather::HAIL;
-		if (ws == "GS") w = Weather::SMALL_HAIL;
-		if (ws == "UP") w = Weather::UNDETERMINED;
-		if (!w.has_value()) return error;
+		switch (packKey(precipStr.substr(0,2))) {
+			case packKey("DZ"): w = Weather::DRIZZLE; break;
+			case packKey("RA"): w = Weather::RAIN; break;
+			case packKey("SN"): w = Weather::SNOW; break;
+			case packKey("SG"): w = Weather::SNOW_GRAINS; break;
+			case packKey("PL"): w = Weather::ICE_PELLETS; break;
+			case packKey("GR"): w = Weather::HAIL; break;
+			case packKey("GS"): w = Weather::SMALL_HAIL; break;
+			case packKey("UP"): w = Weather::UNDETERMINED; break;
+			default: return error;
+		}
 		if (isDescriptorShAllowed(*w)) allowShDecriptor = true;
 		if (isDescriptorFzAllowed(*w)) allowFzDecriptor = true;
-		for (auto j = 0u; j < resultWeather.size(); j++)
+		for (auto j = 0u; j < resultWeatherSize; j++)
 			if (resultWeather[j] == *w) return error;
-		resultWeather.push_back(*w);
+		resultWeather[resultWeatherSize++] = *w;
 		precipStr = precipStr.substr(2);
 	}
 	if (!precipStr.empty()) return error;
 	if (!allowShDecriptor && resultDescriptor == Descriptor::SHOWERS) return error;
 	if (!allowFzDecriptor && resultDescriptor == Descriptor::FREEZING) return error;
 	WeatherPhenomena result;
-	result.data = pack(resultQualifier, resultDescriptor, resultWeather);
+	result.data = pack(resultQualifier,
+		resultDescriptor,
+		resultWeatherSize,
+		resultWeather[0],
+		resultWeather[1],
+		resultWeather[2]);
 	return result;
 }
 
@@ -3970,34 +4914,35 @@ inline uint32_t WeatherPhenomena::pack(Qualifier q,
 	return result;
 }
 
-inline uint32_t WeatherPhenomena::pack(Qualifier q,
-	Descriptor d,
-	std::vector<Weather> w,
-	Event e)
-{
-	const size_t sz = (w.size() <= 3 ? w.size() : 3);
-	const Weather w1 = (sz >= 1 ? w[0] : Weather::NOT_REPORTED);
-	const Weather w2 = (sz >= 2 ? w[1] : Weather::NOT_REPORTED);
-	const Weather w3 = (sz == 3 ? w[2] : Weather::NOT_REPORTED);
-	return pack(q, d, w.size(), w1, w2, w3, e);
-}
-
 std::optional <WeatherPhenomena> WeatherPhenomena::fromWeatherBeginEndString(
-	const std::string & s,
+	std::string_view s,
 	const MetafTime & reportTime,
 	const WeatherPhenomena & previous)
 {
 	std::optional <WeatherPhenomena> error;
-	static const std::regex rgx("((?:[A-Z][A-Z]){0,4})([BE])(\\d\\d)?(\\d\\d)");
-	static const auto matchPhenomena = 1, matchEvent = 2;
-	static const auto matchHour = 3, matchMinute = 4;
-
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return error;
+	//static const std::regex rgx("((?:[A-Z][A-Z]){0,4})([BE])(\\d\\d)?(\\d\\d)");
+	// Up to four 2-char phenomena followed by event char B or E, so the
+	// letters before the time are an odd number no longer than 9 chars
+	auto eventPos = 0u;
+	while (eventPos < s.length() && isUpperLetter(s[eventPos])) eventPos++;
+	static const auto maxLetters = 9u;
+	if (!(eventPos % 2) || eventPos > maxLetters) return error;
+	eventPos--;
+	const auto eventChar = s[eventPos];
+	if (eventChar != 'B' && eventChar != 'E') return error;
+	const auto timeStr = s.substr(eventPos + 1);
+	if (timeStr.length() != 2 && timeStr.length() != 4) return error;
+	const auto timeMinute = strToUint(timeStr, timeStr.length() - 2, 2);
+	if (!timeMinute.has_value()) return error;
+	std::optional<unsigned int> timeHour;
+	if (timeStr.length() == 4) {
+		timeHour = strToUint(timeStr, 0, 2);
+		if (!timeHour.has_value()) return error;
+	}
 
 	WeatherPhenomena result;
 
-	if (const auto phstr = match.str(matchPhenomena); !phstr.empty()) {
+	if (const auto phstr = s.substr(0, eventPos); !phstr.empty()) {
 		const auto ph = fromString(phstr);
 		if (!ph.has_value()) return error;
 		result = *ph;
@@ -4008,27 +4953,28 @@ std::optional <WeatherPhenomena> WeatherPhenomena::fromWeatherBeginEndString(
 
 	Event resultEvent;
 
-	if (match.str(matchEvent) == "B") resultEvent = Event::BEGINNING;
-	if (match.str(matchEvent) == "E") resultEvent = Event::ENDING;
+	if (eventChar == 'B') resultEvent = Event::BEGINNING;
+	if (eventChar == 'E') resultEvent = Event::ENDING;
 
-	result.data = pack(result.qualifier(),
-		result.descriptor(),
-		result.weather(),
-		resultEvent);
+	result.data &= ~(eventMask << eventShiftBits);
+	result.data |= (static_cast<uint32_t>(resultEvent) << eventShiftBits);
 
-	unsigned int hour = reportTime.hour();
-	unsigned int minute = static_cast<unsigned int>(std::stoi(match.str(matchMinute)));
-	if (const auto h = match.str(matchHour); !h.empty())
-		hour = static_cast<unsigned int>(std::stoi(h));
-	result.tm = MetafTime(hour, minute);
+	const unsigned int hour = timeHour.value_or(reportTime.hour());
+	result.tm = MetafTime(hour, *timeMinute);
 
 	return result;
 }
 
 bool WeatherPhenomena::isValid() const {
-	const auto w = weather();
+	// Weather is read from packed data since weather() allocates a vector
+	const Weather w[wSize] = {
+		static_cast<Weather>((data >> weather0ShiftBits) & weatherMask),
+		static_cast<Weather>((data >> weather1ShiftBits) & weatherMask),
+		static_cast<Weather>((data >> weather2ShiftBits) & weatherMask)
+	};
+	const auto wNum = (data >> weatherCountShiftBits) & weatherCountMask;
 	// Empty weather phenomena is not valid
-	if (qualifier() == Qualifier::NONE && descriptor() == Descriptor::NONE && !w.size())
+	if (qualifier() == Qualifier::NONE && descriptor() == Descriptor::NONE && !wNum)
 		return false;
 	// Event time must be valid if present
 	if (tm.has_value() && !tm->isValid()) return false;
@@ -4036,7 +4982,7 @@ bool WeatherPhenomena::isValid() const {
 	// can potentially freeze, i.e. DZ RA, or with UP, or with FG
 	if (descriptor() == Descriptor::FREEZING) {
 		bool dzRaUpFg = false;
-		for (auto i = 0u; i < wSize; i++) {
+		for (auto i = 0u; i < wNum; i++) {
 			if (w[i] == Weather::DRIZZLE || w[i] == Weather::RAIN ||
 				w[i] == Weather::UNDETERMINED || w[i] == Weather::FOG)
 			{
@@ -4051,7 +4997,7 @@ bool WeatherPhenomena::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<CloudType> CloudType::fromString(const std::string & s) {
+std::optional<CloudType> CloudType::fromString(std::string_view s) {
 	static const std::optional<CloudType> error;
 	if (s.empty()) return error;
 	if (s[0] >= '0' && s[0] <= '9') {
@@ -4080,96 +5026,144 @@ std::optional<CloudType> CloudType::fromString(const std::string & s) {
 	}
 }
 
-std::optional<CloudType> CloudType::fromStringObscuration(const std::string & s) {
+std::optional<CloudType> CloudType::fromStringObscuration(std::string_view s) {
 	auto type = Type::NOT_REPORTED;
-	if (s == "BLSN") type = Type::BLOWING_SNOW;
-	if (s == "BLDU") type = Type::BLOWING_DUST;
-	if (s == "BLSA") type = Type::BLOWING_SAND;
-	if (s == "VA") type = Type::VOLCANIC_ASH;
-	if (s == "FU") type = Type::SMOKE;
-	if (s == "FG") type = Type::FOG;
-	if (type == Type::NOT_REPORTED) return std::optional<CloudType>();
+	switch (packKey(s)) {
+		case packKey("BLSN"): type = Type::BLOWING_SNOW; break;
+		case packKey("BLDU"): type = Type::BLOWING_DUST; break;
+		case packKey("BLSA"): type = Type::BLOWING_SAND; break;
+		case packKey("VA"):   type = Type::VOLCANIC_ASH; break;
+		case packKey("FU"):   type = Type::SMOKE; break;
+		case packKey("FG"):   type = Type::FOG; break;
+		default: return std::optional<CloudType>();
+	}
 	return CloudType(type, Distance(), 0);
 }
 
 
-CloudType::Type CloudType::cloudTypeFromString(const std::string & s) {
-	if (s == "CB")    return Type::CUMULONIMBUS;
-	if (s == "TCU")   return Type::TOWERING_CUMULUS;
-	if (s == "CU")    return Type::CUMULUS;
-	if (s == "CF")    return Type::CUMULUS_FRACTUS;
-	if (s == "SC")    return Type::STRATOCUMULUS;
-	if (s == "NS")    return Type::NIMBOSTRATUS;
-	if (s == "ST")    return Type::STRATUS;
-	if (s == "SF")    return Type::STRATUS_FRACTUS;
-	if (s == "AS")    return Type::ALTOSTRATUS;
-	if (s == "AC")    return Type::ALTOCUMULUS;
-	if (s == "ACC")   return Type::ALTOCUMULUS_CASTELLANUS;
-	if (s == "CI")    return Type::CIRRUS;
-	if (s == "CS")    return Type::CIRROSTRATUS;
-	if (s == "CC")    return Type::CIRROCUMULUS;
-	return Type::NOT_REPORTED;
+CloudType::Type CloudType::cloudTypeFromString(std::string_view s) {
+	switch (packKey(s)) {
+		case packKey("CB"):    return Type::CUMULONIMBUS;
+		case packKey("TCU"):   return Type::TOWERING_CUMULUS;
+		case packKey("CU"):    return Type::CUMULUS;
+		case packKey("CF"):    return Type::CUMULUS_FRACTUS;
+		case packKey("SC"):    return Type::STRATOCUMULUS;
+		case packKey("NS"):    return Type::NIMBOSTRATUS;
+		case packKey("ST"):    return Type::STRATUS;
+		case packKey("SF"):    return Type::STRATUS_FRACTUS;
+		case packKey("AS"):    return Type::ALTOSTRATUS;
+		case packKey("AC"):    return Type::ALTOCUMULUS;
+		case packKey("ACC"):   return Type::ALTOCUMULUS_CASTELLANUS;
+		case packKey("CI"):    return Type::CIRRUS;
+		case packKey("CS"):    return Type::CIRROSTRATUS;
+		case packKey("CC"):    return Type::CIRROCUMULUS;
+		default:               return Type::NOT_REPORTED;
+	}
 }
 
-CloudType::Type CloudType::cloudTypeOrObscurationFromString(const std::string & s) {
+CloudType::Type CloudType::cloudTypeOrObscurationFromString(std::string_view s) {
 	if (const auto t = cloudTypeFromString(s); t != Type::NOT_REPORTED) return t;
-	if (s == "BLSN")  return Type::BLOWING_SNOW;
-	if (s == "BLDU")  return Type::BLOWING_DUST;
-	if (s == "BLSA")  return Type::BLOWING_SAND;
-	if (s == "IC")    return Type::ICE_CRYSTALS;
-	if (s == "RA")    return Type::RAIN;
-	if (s == "DZ")    return Type::DRIZZLE;
-	if (s == "SN")    return Type::SNOW;
-	if (s == "PL")    return Type::ICE_PELLETS;
-	if (s == "FU")    return Type::SMOKE;
-	if (s == "FG")    return Type::FOG;
-	if (s == "BR")    return Type::MIST;
-	if (s == "HZ")    return Type::HAZE;
-	if (s == "VA") 	  return Type::VOLCANIC_ASH;
-	return Type::NOT_REPORTED;
+	switch (packKey(s)) {
+		case packKey("BLSN"):  return Type::BLOWING_SNOW;
+		case packKey("BLDU"):  return Type::BLOWING_DUST;
+		case packKey("BLSA"):  return Type::BLOWING_SAND;
+		case packKey("IC"):    return Type::ICE_CRYSTALS;
+		case packKey("RA"):    return Type::RAIN;
+		case packKey("DZ"):    return Type::DRIZZLE;
+		case packKey("SN"):    return Type::SNOW;
+		case packKey("PL"):    return Type::ICE_PELLETS;
+		case packKey("FU"):    return Type::SMOKE;
+		case packKey("FG"):    return Type::FOG;
+		case packKey("BR"):    return Type::MIST;
+		case packKey("HZ"):    return Type::HAZE;
+		case packKey("VA"):    return Type::VOLCANIC_ASH;
+		default:               return Type::NOT_REPORTED;
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<KeywordGroup> KeywordGroup::parse(const std::string & group,
+std::optional<KeywordGroup> KeywordGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
-	if (reportPart == ReportPart::HEADER) {
-		if (group == "METAR") return KeywordGroup(Type::METAR);
-		if (group == "SPECI") return KeywordGroup(Type::SPECI);
-		if (group == "TAF") return KeywordGroup(Type::TAF);
-		if (group == "AMD") return KeywordGroup(Type::AMD);
-	}
-	if (reportPart == ReportPart::HEADER || reportPart == ReportPart::METAR) {
-		if (group == "COR") return KeywordGroup(Type::COR);
-	}
-	if (reportPart == ReportPart::HEADER ||
-		reportPart == ReportPart::METAR ||
-		reportPart == ReportPart::TAF) {
-			if (group == "NIL") return KeywordGroup(Type::NIL);
-			if (group == "CNL") return KeywordGroup(Type::CNL);
-	}
-	if (reportPart == ReportPart::METAR) {
-		if (group == "AUTO") return KeywordGroup(Type::AUTO);
-	}
-	if (reportPart == ReportPart::METAR || reportPart == ReportPart::TAF) {
-		if (group == "CAVOK") return KeywordGroup(Type::CAVOK);
-		if (group == "RMK") return KeywordGroup(Type::RMK);
-	}
-	if (reportPart == ReportPart::RMK) {
-		if (group == "AO1") return KeywordGroup(Type::AO1);
-		if (group == "AO2") return KeywordGroup(Type::AO2);
-		if (group == "AO1A") return KeywordGroup(Type::AO1A);
-		if (group == "AO2A") return KeywordGroup(Type::AO2A);
-		if (group == "NOSPECI") return KeywordGroup(Type::NOSPECI);
+	static const std::optional<KeywordGroup> notRecognised;
+	const bool isHeader = (reportPart == ReportPart::HEADER);
+	const bool isMetar = (reportPart == ReportPart::METAR);
+	const bool isTaf = (reportPart == ReportPart::TAF);
+	const bool isRemark = (reportPart == ReportPart::RMK);
+	switch (packKey(group)) {
+		case packKey("METAR"):
+		if (isHeader) return KeywordGroup(Type::METAR);
+		break;
+
+		case packKey("SPECI"):
+		if (isHeader) return KeywordGroup(Type::SPECI);
+		break;
+
+		case packKey("TAF"):
+		if (isHeader) return KeywordGroup(Type::TAF);
+		break;
+
+		case packKey("AMD"):
+		if (isHeader) return KeywordGroup(Type::AMD);
+		break;
+
+		case packKey("COR"):
+		if (isHeader || isMetar) return KeywordGroup(Type::COR);
+		break;
+
+		case packKey("NIL"):
+		if (isHeader || isMetar || isTaf) return KeywordGroup(Type::NIL);
+		break;
+
+		case packKey("CNL"):
+		if (isHeader || isMetar || isTaf) return KeywordGroup(Type::CNL);
+		break;
+
+		case packKey("AUTO"):
+		if (isMetar) return KeywordGroup(Type::AUTO);
+		break;
+
+		case packKey("CAVOK"):
+		if (isMetar || isTaf) return KeywordGroup(Type::CAVOK);
+		break;
+
+		case packKey("RMK"):
+		if (isMetar || isTaf) return KeywordGroup(Type::RMK);
+		break;
+
+		case packKey("AO1"):
+		if (isRemark) return KeywordGroup(Type::AO1);
+		break;
+
+		case packKey("AO2"):
+		if (isRemark) return KeywordGroup(Type::AO2);
+		break;
+
+		case packKey("AO1A"):
+		if (isRemark) return KeywordGroup(Type::AO1A);
+		break;
+
+		case packKey("AO2A"):
+		if (isRemark) return KeywordGroup(Type::AO2A);
+		break;
+
+		case packKey("NOSPECI"):
+		if (isRemark) return KeywordGroup(Type::NOSPECI);
+		break;
+
+		case packKey("$"):
+		return KeywordGroup(Type::MAINTENANCE_INDICATOR);
+
+		default:
+		break;
 	}
-	if (group == "$") return KeywordGroup(Type::MAINTENANCE_INDICATOR);
-	return std::optional<KeywordGroup>();
+	return notRecognised;
 }
 
-AppendResult KeywordGroup::append(const std::string & group,
+AppendResult KeywordGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4179,22 +5173,25 @@ AppendResult KeywordGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<LocationGroup> LocationGroup::parse(const std::string & group,
+std::optional<LocationGroup> LocationGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	static const std::optional<LocationGroup> notRecognised;
 	if (reportPart != ReportPart::HEADER) return notRecognised;
-	static const std::regex rgx = std::regex("[A-Z][A-Z0-9]{3}");
-	if (!regex_match(group, rgx)) return notRecognised;
+	//static const std::regex rgx = std::regex("[A-Z][A-Z0-9]{3}");
+	if (group.length() != locationLength) return notRecognised;
+	if (!isUpperLetter(group[0])) return notRecognised;
+	for (auto i = 1u; i < locationLength; i++)
+		if (!isUpperLetter(group[i]) && !isDigit(group[i])) return notRecognised;
 	LocationGroup result;
-	strncpy(result.location, group.c_str(), locationLength);
+	strncpy(result.location, group.data(), locationLength);
 	result.location[locationLength] = '\0';
 	return result;
 }
 
-AppendResult LocationGroup::append(const std::string & group,
+AppendResult LocationGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4204,16 +5201,16 @@ AppendResult LocationGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<ReportTimeGroup> ReportTimeGroup::parse(const std::string & group,
+std::optional<ReportTimeGroup> ReportTimeGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	static const std::optional<ReportTimeGroup> notRecognised;
-	static const std::regex rgx ("\\d\\d\\d\\d\\d\\dZ");
+	//static const std::regex rgx ("\\d\\d\\d\\d\\d\\dZ");
 	static const auto posTime = 0, lenTime = 6;
 	if (reportPart != ReportPart::HEADER) return notRecognised;
-	if (!regex_match(group, rgx)) return notRecognised;
+	if (group.length() != lenTime + 1 || group[lenTime] != 'Z') return notRecognised;
 	const auto tm = MetafTime::fromStringDDHHMM(group.substr(posTime, lenTime));
 	if (!tm.has_value()) return notRecognised;
 	if (!tm->day().has_value()) return notRecognised;
@@ -4222,7 +5219,7 @@ std::optional<ReportTimeGroup> ReportTimeGroup::parse(const std::string & group,
 	return g;
 }
 
-AppendResult ReportTimeGroup::append(const std::string & group,
+AppendResult ReportTimeGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4232,7 +5229,7 @@ AppendResult ReportTimeGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<TrendGroup> TrendGroup::parse(const std::string & group,
+std::optional<TrendGroup> TrendGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4268,7 +5265,7 @@ std::optional<TrendGroup> TrendGroup::parse(const std::string & group,
 	return std::optional<TrendGroup>();
 }
 
-AppendResult TrendGroup::append(const std::string & group,
+AppendResult TrendGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4283,14 +5280,13 @@ AppendResult TrendGroup::append(const std::string & group,
 	return AppendResult::NOT_APPENDED;
 }
 
-std::optional<TrendGroup> TrendGroup::fromTimeSpan(const std::string & s) {
+std::optional<TrendGroup> TrendGroup::fromTimeSpan(std::string_view s) {
 	static const std::optional<TrendGroup> notRecognised;
-	static const std::regex rgx("(\\d\\d\\d\\d)/(\\d\\d\\d\\d)");
-	static const auto matchFrom = 1, matchTill = 2;
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return notRecognised;
-	const auto from = MetafTime::fromStringDDHH(match.str(matchFrom));
-	const auto till = MetafTime::fromStringDDHH(match.str(matchTill));
+	//static const std::regex rgx("(\\d\\d\\d\\d)/(\\d\\d\\d\\d)");
+	static const auto posFrom = 0, posTill = 5, lenTime = 4;
+	if (s.length() != posTill + lenTime || s[lenTime] != '/') return notRecognised;
+	const auto from = MetafTime::fromStringDDHH(s.substr(posFrom, lenTime));
+	const auto till = MetafTime::fromStringDDHH(s.substr(posTill, lenTime));
 	if (!from.has_value() || !till.has_value()) return notRecognised;
 
 	TrendGroup result;
@@ -4301,14 +5297,13 @@ std::optional<TrendGroup> TrendGroup::fromTimeSpan(const std::string & s) {
 	return result;
 }
 
-std::optional<TrendGroup> TrendGroup::fromTimeSpanHHMM(const std::string & s) {
+std::optional<TrendGroup> TrendGroup::fromTimeSpanHHMM(std::string_view s) {
 	static const std::optional<TrendGroup> notRecognised;
-	static const std::regex rgx("(\\d\\d\\d\\d)/(\\d\\d\\d\\d)");
-	static const auto matchFrom = 1, matchTill = 2;
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return notRecognised;
-	const auto from = MetafTime::fromStringDDHHMM(match.str(matchFrom));
-	const auto till = MetafTime::fromStringDDHHMM(match.str(matchTill));
+	//static const std::regex rgx("(\\d\\d\\d\\d)/(\\d\\d\\d\\d)");
+	static const auto posFrom = 0, posTill = 5, lenTime = 4;
+	if (s.length() != posTill + lenTime || s[lenTime] != '/') return notRecognised;
+	const auto from = MetafTime::fromStringDDHHMM(s.substr(posFrom, lenTime));
+	const auto till = MetafTime::fromStringDDHHMM(s.substr(posTill, lenTime));
 	if (!from.has_value() || !till.has_value()) return notRecognised;
 
 	TrendGroup result;
@@ -4319,11 +5314,12 @@ std::optional<TrendGroup> TrendGroup::fromTimeSpanHHMM(const std::string & s) {
 	return result;
 }
 
-std::optional<TrendGroup> TrendGroup::fromFm(const std::string & s) {
+std::optional<TrendGroup> TrendGroup::fromFm(std::string_view s) {
 	static const std::optional<TrendGroup> notRecognised;
-	static const std::regex rgx("FM\\d\\d\\d\\d\\d\\d");
+	//static const std::regex rgx("FM\\d\\d\\d\\d\\d\\d");
 	static const auto posTime = 2, lenTime = 6;
-	if (!regex_match(s, rgx)) return notRecognised;
+	if (s.length() != posTime + lenTime || s.substr(0, posTime) != "FM")
+		return notRecognised;
 	const auto time = MetafTime::fromStringDDHHMM(s.substr(posTime, lenTime));
 	if (!time.has_value()) return notRecognised;
 
@@ -4333,26 +5329,26 @@ std::optional<TrendGroup> TrendGroup::fromFm(const std::string & s) {
 	return result;
 }
 
-std::optional<TrendGroup> TrendGroup::fromTrendTime(const std::string & s) {
+std::optional<TrendGroup> TrendGroup::fromTrendTime(std::string_view s) {
 	static const std::optional<TrendGroup> notRecognised;
-	static const std::regex rgx("([FTA][MLT])(\\d\\d\\d\\d)");
-	static const auto matchType = 1, matchTime = 2;
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return notRecognised;
-	const auto time = MetafTime::fromStringDDHHMM(match.str(matchTime));
+	//static const std::regex rgx("([FTA][MLT])(\\d\\d\\d\\d)");
+	static const auto posTime = 2, lenTime = 4;
+	if (s.length() != posTime + lenTime) return notRecognised;
+	const auto typeStr = s.substr(0, posTime);
+	const auto time = MetafTime::fromStringDDHHMM(s.substr(posTime, lenTime));
 	if (!time.has_value()) return notRecognised;
 	TrendGroup result;
-	if (match.str(matchType) == "FM") {
+	if (typeStr == "FM") {
 		result.t = Type::FROM;
 		result.tFrom = time;
 		return result;
 	}
-	if (match.str(matchType) == "TL") {
+	if (typeStr == "TL") {
 		result.t = Type::UNTIL;
 		result.tTill = time;
 		return result;
 	}
-	if (match.str(matchType) == "AT") {
+	if (typeStr == "AT") {
 		result.t = Type::AT;
 		result.tAt = time;
 		return result;
@@ -4467,7 +5463,7 @@ void TrendGroup::combineTime(const TrendGroup & nextTrendGroup) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<WindGroup> WindGroup::parse(const std::string & group,
+std::optional<WindGroup> WindGroup::parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata)
 {
@@ -4492,50 +5488,85 @@ std::optional<WindGroup> WindGroup::parse(const std::string & group,
 	if (const auto result = parseVariableSector(group); result.has_value())
 		return *result;
 
-	static const std::regex windRgx("(?:WS(\\d\\d\\d)/)?"
-		"(\\d\\d0|VRB|///)([1-9]?\\d\\d|//)(?:G([1-9]?\\d\\d))?([KM][TMP][HS]?)");
-	static const auto matchWindShearHeight = 1, matchWindDir = 2;
-	static const auto matchWindSpeed = 3, matchWindGust = 4, matchWindUnit = 5;
+	//static const std::regex windRgx("(?:WS(\\d\\d\\d)/)?"
+	//	"(\\d\\d0|VRB|///)([1-9]?\\d\\d|//)(?:G([1-9]?\\d\\d))?([KM][TMP][HS]?)");
 
 	// Surface wind or wind shear, e.g. dd0ssKT or dd0ssGggMPS or WShhhdd0ssGggKT
-	if (std::smatch match; std::regex_match(group, match, windRgx)) {
-		const auto speedUnit = Speed::unitFromString(match.str(matchWindUnit));
-		if (!speedUnit.has_value()) return notRecognised;
-		const auto speed = Speed::fromString(match.str(matchWindSpeed), *speedUnit);
-		if (!speed.has_value()) return notRecognised;
-
-		WindGroup result;
-
-		if (!match.length(matchWindShearHeight) &&
-			!match.length(matchWindGust) &&
-			match.str(matchWindDir) == "000" &&
-			match.str(matchWindSpeed) == "00")
-		{
-			//00000KT or 00000MPS or 00000KMH: calm wind
-			result.windType = Type::SURFACE_WIND_CALM;
-			result.wSpeed = *speed;
-			return result;
-		}
+	std::size_t pos = 0;
+	std::string_view windShearHeightStr;
+	if (group.substr(0, 2) == "WS") {
+		static const auto heightPos = 2u, heightLen = 3u;
+		if (!strToUint(group, heightPos, heightLen).has_value()) return notRecognised;
+		pos = heightPos + heightLen;
+		if (pos >= group.length() || group[pos] != '/') return notRecognised;
+		windShearHeightStr = group.substr(heightPos, heightLen);
+		pos++;
+	}
+	static const auto dirLen = 3u;
+	if (pos + dirLen > group.length()) return notRecognised;
+	const auto windDirStr = group.substr(pos, dirLen);
+	if (windDirStr != "VRB" && windDirStr != "///" &&
+		(!strToUint(windDirStr, 0, dirLen).has_value() || windDirStr[2] != '0'))
+			return notRecognised;
+	pos += dirLen;
+	std::string_view windSpeedStr;
+	if (group.substr(pos, 2) == "//") {
+		windSpeedStr = group.substr(pos, 2);
+	} else {
+		const auto len = speedValueLength(group, pos);
+		if (!len) return notRecognised;
+		windSpeedStr = group.substr(pos, len);
+	}
+	pos += windSpeedStr.length();
+	std::string_view windGustStr;
+	if (pos < group.length() && group[pos] == 'G') {
+		const auto len = speedValueLength(group, ++pos);
+		if (!len) return notRecognised;
+		windGustStr = group.substr(pos, len);
+		pos += len;
+	}
+	const auto windUnitStr = group.substr(pos);
+	if (windUnitStr.length() < 2 || windUnitStr.length() > 3) return notRecognised;
+	if (windUnitStr[0] != 'K' && windUnitStr[0] != 'M') return notRecognised;
+	if (windUnitStr[1] != 'T' && windUnitStr[1] != 'M' && windUnitStr[1] != 'P')
+		return notRecognised;
+	if (windUnitStr.length() == 3 && windUnitStr[2] != 'H' && windUnitStr[2] != 'S')
+		return notRecognised;
+
+	const auto speedUnit = Speed::unitFromString(windUnitStr);
+	if (!speedUnit.has_value()) return notRecognised;
+	const auto speed = Speed::fromString(windSpeedStr, *speedUnit);
+	if (!speed.has_value()) return notRecognised;
+
+	WindGroup result;
 
-		const auto dir = Direction::fromDegreesString(match.str(matchWindDir));
-		if (!dir.has_value()) return notRecognised;
-		result.windDir = *dir;
+	if (windShearHeightStr.empty() &&
+		windGustStr.empty() &&
+		windDirStr == "000" &&
+		windSpeedStr == "00")
+	{
+		//00000KT or 00000MPS or 00000KMH: calm wind
+		result.windType = Type::SURFACE_WIND_CALM;
 		result.wSpeed = *speed;
-		const auto gust = Speed::fromString(match.str(matchWindGust), *speedUnit);
-		if (gust.has_value()) result.gSpeed = *gust;
-		const auto wsHeight = Distance::fromHeightString(match.str(matchWindShearHeight));
-		result.windType = Type::SURFACE_WIND;
-		if (wsHeight.has_value()) {
-			result.windType = Type::WIND_SHEAR;
-			result.wShHeight = *wsHeight;
-		}
 		return result;
 	}
 
-	return notRecognised;
+	const auto dir = Direction::fromDegreesString(windDirStr);
+	if (!dir.has_value()) return notRecognised;
+	result.windDir = *dir;
+	result.wSpeed = *speed;
+	const auto gust = Speed::fromString(windGustStr, *speedUnit);
+	if (gust.has_value()) result.gSpeed = *gust;
+	const auto wsHeight = Distance::fromHeightString(windShearHeightStr);
+	result.windType = Type::SURFACE_WIND;
+	if (wsHeight.has_value()) {
+		result.windType = Type::WIND_SHEAR;
+		result.wShHeight = *wsHeight;
+	}
+	return result;
 }
 
-AppendResult WindGroup::append(const std::string & group,
+AppendResult WindGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4582,25 +5613,36 @@ AppendResult WindGroup::append(const std::string & group,
 	}
 }
 
-std::optional<WindGroup> WindGroup::parseVariableSector(const std::string & group) {
-	static const std::optional<WindGroup> notRecognised;
-	static const std::regex varWindRgx("(\\d\\d0)V(\\d\\d0)");
-	static const auto matchVarWindBegin = 1, matchVarWindEnd = 2;
+std::size_t WindGroup::speedValueLength(std::string_view group, std::size_t pos) {
+	// Speed value is 2 digits or 3 digits without leading zero ([1-9]?\\d\\d)
+	auto len = 0u;
+	while (pos + len < group.length() && isDigit(group[pos + len])) len++;
+	static const auto minLen = 2u, maxLen = 3u;
+	if (len == minLen || (len == maxLen && group[pos] != '0')) return len;
+	return 0;
+}
 
-	std::smatch match;
-	if (!std::regex_match(group, match, varWindRgx)) return notRecognised;
+std::optional<WindGroup> WindGroup::parseVariableSector(std::string_view group) {
+	static const std::optional<WindGroup> notRecognised;
+	//static const std::regex varWindRgx("(\\d\\d0)V(\\d\\d0)");
+	static const auto beginPos = 0u, endPos = 4u, dirLen = 3u;
+	if (group.length() != endPos + dirLen || group[dirLen] != 'V') return notRecognised;
+	if (!strToUint(group, beginPos, dirLen).has_value() || group[beginPos + 2] != '0')
+		return notRecognised;
+	if (!strToUint(group, endPos, dirLen).has_value() || group[endPos + 2] != '0')
+		return notRecognised;
 	WindGroup result;
-	const auto begin = Direction::fromDegreesString(match.str(matchVarWindBegin));
+	const auto begin = Direction::fromDegreesString(group.substr(beginPos, dirLen));
 	if (!begin.has_value()) return notRecognised;
 	result.vsecBegin = *begin;
-	const auto end = Direction::fromDegreesString(match.str(matchVarWindEnd));
+	const auto end = Direction::fromDegreesString(group.substr(endPos, dirLen));
 	if (!end.has_value()) return notRecognised;
 	result.vsecEnd = *end;
 	result.windType = Type::VARIABLE_WIND_SECTOR;
 	return result;
 }
 
-AppendResult WindGroup::appendVariableSector(const std::string & group) {
+AppendResult WindGroup::appendVariableSector(std::string_view group) {
 	if (const auto vs = parseVariableSector(group); vs.has_value()) {
 		windType = Type::SURFACE_WIND_WITH_VARIABLE_SECTOR;
 		vsecBegin = vs->vsecBegin;
@@ -4610,40 +5652,51 @@ AppendResult WindGroup::appendVariableSector(const std::string & group) {
 	return AppendResult::NOT_APPENDED;
 }
 
-AppendResult WindGroup::appendPeakWind(const std::string & group,
+AppendResult WindGroup::appendPeakWind(std::string_view group,
 	const ReportMetadata & reportMetadata)
 {
-
-	static const std::regex pkWndRgx("(\\d\\d0)([1-9]?\\d\\d)/(\\d\\d)?(\\d\\d)");
-	static const auto matchDir = 1, matchSpeed = 2;
-	static const auto matchHour = 3, matchMinute = 4;
-
-	std::smatch match;
-	if (!std::regex_match(group, match, pkWndRgx)) return AppendResult::GROUP_INVALIDATED;
+	//static const std::regex pkWndRgx("(\\d\\d0)([1-9]?\\d\\d)/(\\d\\d)?(\\d\\d)");
+	static const auto dirLen = 3u, speedPos = 3u;
+	if (!strToUint(group, 0, dirLen).has_value() || group[dirLen - 1] != '0')
+		return AppendResult::GROUP_INVALIDATED;
+	const auto speedLen = speedValueLength(group, speedPos);
+	if (!speedLen) return AppendResult::GROUP_INVALIDATED;
+	const auto timePos = speedPos + speedLen + 1;
+	if (timePos > group.length() || group[timePos - 1] != '/')
+		return AppendResult::GROUP_INVALIDATED;
+	const auto timeStr = group.substr(timePos);
+	if (timeStr.length() != 2 && timeStr.length() != 4)
+		return AppendResult::GROUP_INVALIDATED;
+	const auto timeMinute = strToUint(timeStr, timeStr.length() - 2, 2);
+	if (!timeMinute.has_value()) return AppendResult::GROUP_INVALIDATED;
+	std::optional<unsigned int> timeHour;
+	if (timeStr.length() == 4) {
+		timeHour = strToUint(timeStr, 0, 2);
+		if (!timeHour.has_value()) return AppendResult::GROUP_INVALIDATED;
+	}
 
 	windType = Type::PEAK_WIND;
-	const auto dir = Direction::fromDegreesString(match.str(matchDir));
+	const auto dir = Direction::fromDegreesString(group.substr(0, dirLen));
 	if (!dir.has_value()) return AppendResult::GROUP_INVALIDATED;
 	windDir = *dir;
 
 	const auto speed =
-		Speed::fromString(match.str(matchSpeed), Speed::Unit::KNOTS);
+		Speed::fromString(group.substr(speedPos, speedLen), Speed::Unit::KNOTS);
 	if (!speed.has_value()) return AppendResult::GROUP_INVALIDATED;
 	wSpeed = *speed;
 
-	if (!reportMetadata.reportTime.has_value() && match.str(matchHour).empty()) {
+	if (!reportMetadata.reportTime.has_value() && !timeHour.has_value()) {
 		return AppendResult::GROUP_INVALIDATED;
 	}
-	const auto hour = match.str(matchHour).empty() ?
-		reportMetadata.reportTime->hour() : stoi(match.str(matchHour));
-	const auto minute = stoi(match.str(matchMinute));
-	evTime = MetafTime(hour, minute);
+	const auto hour = timeHour.has_value() ?
+		*timeHour : reportMetadata.reportTime->hour();
+	evTime = MetafTime(hour, *timeMinute);
 	incompleteText = IncompleteText::NONE;
 
 	return AppendResult::APPENDED;
 }
 
-AppendResult WindGroup::appendWindShift(const std::string & group,
+AppendResult WindGroup::appendWindShift(std::string_view group,
 	const ReportMetadata & reportMetadata)
 {
 	//Append FROPA to wind shift group with or without time
@@ -4692,7 +5745,7 @@ bool WindGroup::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<VisibilityGroup> VisibilityGroup::parse(const std::string & group,
+std::optional<VisibilityGroup> VisibilityGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4726,7 +5779,7 @@ std::optional<VisibilityGroup> VisibilityGroup::parse(const std::string & group,
 	return std::optional<VisibilityGroup>();
 }
 
-AppendResult VisibilityGroup::append(const std::string & group,
+AppendResult VisibilityGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4828,7 +5881,7 @@ AppendResult VisibilityGroup::append(const std::string & group,
 }
 
 std::optional<VisibilityGroup> VisibilityGroup::fromIncompleteInteger(
-	const std::string & group)
+	std::string_view group)
 {
 	static const std::optional<VisibilityGroup> error;
 	VisibilityGroup	result;
@@ -4839,52 +5892,101 @@ std::optional<VisibilityGroup> VisibilityGroup::fromIncompleteInteger(
 }
 
 std::optional<VisibilityGroup> VisibilityGroup::fromMeters(
-	const std::string & group)
+	std::string_view group)
 {
 	static const std::optional<VisibilityGroup> notRecognised;
-	static const std::regex rgx("(\\d\\d\\d\\d|////)([NSWE][WED]?[V]?)?");
-	static const auto matchVis = 1, matchDir = 2;
-	std::smatch match;
-	if (std::regex_match(group, match, rgx)) {
-		const auto v = Distance::fromMeterString(match.str(matchVis));
-		if (!v.has_value()) return notRecognised;
-		const auto d = Direction::fromCardinalString(match.str(matchDir));
-		VisibilityGroup result;
-		result.vis = *v;
-		result.dir = d;
-		if (result.dir.has_value()) {
-			if (result.dir->isValue()) result.visType = Type::DIRECTIONAL;
-			if (result.dir->type() == Direction::Type::NDV) result.visType = Type::PREVAILING_NDV;
-		}
-		return result;
+	//static const std::regex rgx("(\\d\\d\\d\\d|////)([NSWE][WED]?[V]?)?");
+	static const auto visLen = 4u;
+	if (group.length() < visLen) return notRecognised;
+	const auto visStr = group.substr(0, visLen);
+	if (visStr != "////" && !strToUint(visStr, 0, visLen).has_value())
+		return notRecognised;
+	const auto dirStr = group.substr(visLen);
+	if (!dirStr.empty()) {
+		if (dirStr[0] != 'N' && dirStr[0] != 'S' && dirStr[0] != 'W' && dirStr[0] != 'E')
+			return notRecognised;
+		auto pos = 1u;
+		if (pos < dirStr.length() &&
+			(dirStr[pos] == 'W' || dirStr[pos] == 'E' || dirStr[pos] == 'D')) pos++;
+		if (pos < dirStr.length() && dirStr[pos] == 'V') pos++;
+		if (pos != dirStr.length()) return notRecognised;
+	}
+	const auto v = Distance::fromMeterString(visStr);
+	if (!v.has_value()) return notRecognised;
+	const auto d = Direction::fromCardinalString(dirStr);
+	VisibilityGroup result;
+	result.vis = *v;
+	result.dir = d;
+	if (result.dir.has_value()) {
+		if (result.dir->isValue()) result.visType = Type::DIRECTIONAL;
+		if (result.dir->type() == Direction::Type::NDV) result.visType = Type::PREVAILING_NDV;
 	}
-	return notRecognised;
+	return result;
 }
 
-std::optional<VisibilityGroup> VisibilityGroup::fromRvr(const std::string & group) {
+std::optional<VisibilityGroup> VisibilityGroup::fromRvr(std::string_view group) {
 	static const std::optional<VisibilityGroup> notRecognised;
-	static const std::regex rgx("(R\\d\\d[RCL]?|R//)/(////|[PM]?\\d\\d\\d\\d)"
-		"(?:V([PM]?\\d\\d\\d\\d))?(FT/?)?([UND/])?");
-	static const auto matchRunway = 1, matchRvr = 2, matchVarRvr = 3, matchUnit = 4;
-	static const auto matchTrend = 5;
-	std::smatch match;
-	if (!regex_match(group, match, rgx)) return notRecognised;
-	const bool unitFeet = match.length(matchUnit);
-	if (match.str(matchRunway) == "R//" && match.str(matchRvr) != "////")
+	//static const std::regex rgx("(R\\d\\d[RCL]?|R//)/(////|[PM]?\\d\\d\\d\\d)"
+	//	"(?:V([PM]?\\d\\d\\d\\d))?(FT/?)?([UND/])?");
+	// RVR value is 4 digits with optional P or M prefix
+	const auto rvrValueLength = [](std::string_view s, std::size_t pos) -> std::size_t {
+		static const auto rvrLen = 4u;
+		const std::size_t prefixLen =
+			(pos < s.length() && (s[pos] == 'P' || s[pos] == 'M')) ? 1 : 0;
+		if (!strToUint(s, pos + prefixLen, rvrLen).has_value()) return 0;
+		return (prefixLen + rvrLen);
+	};
+	static const auto runwayLen = 3u;
+	if (group.length() < runwayLen || group[0] != 'R') return notRecognised;
+	std::size_t pos = runwayLen;
+	if (group.substr(1, 2) != "//") {
+		if (!strToUint(group, 1, 2).has_value()) return notRecognised;
+		if (pos < group.length() &&
+			(group[pos] == 'R' || group[pos] == 'C' || group[pos] == 'L')) pos++;
+	}
+	const auto runwayStr = group.substr(0, pos);
+	if (pos >= group.length() || group[pos] != '/') return notRecognised;
+	pos++;
+	std::string_view rvrStr;
+	if (group.substr(pos, 4) == "////") {
+		rvrStr = group.substr(pos, 4);
+	} else {
+		const auto len = rvrValueLength(group, pos);
+		if (!len) return notRecognised;
+		rvrStr = group.substr(pos, len);
+	}
+	pos += rvrStr.length();
+	std::string_view varRvrStr;
+	if (pos < group.length() && group[pos] == 'V') {
+		const auto len = rvrValueLength(group, ++pos);
+		if (!len) return notRecognised;
+		varRvrStr = group.substr(pos, len);
+		pos += len;
+	}
+	const bool unitFeet = (group.substr(pos, 2) == "FT");
+	if (unitFeet) {
+		pos += 2;
+		if (pos < group.length() && group[pos] == '/') pos++;
+	}
+	const auto trendStr = group.substr(pos);
+	if (trendStr.length() > 1) return notRecognised;
+	if (!trendStr.empty() && trendStr[0] != 'U' && trendStr[0] != 'N' &&
+		trendStr[0] != 'D' && trendStr[0] != '/') return notRecognised;
+	if (runwayStr == "R//" && rvrStr != "////")
 		return notRecognised;
-	if (match.str(matchRunway) == "R//" && match.str(matchTrend) == "/")
+	if (runwayStr == "R//" && trendStr == "/")
 		return notRecognised;
-	const auto runway = Runway::fromString(match.str(matchRunway));
-	if (!runway.has_value() && match.str(matchRunway) != "R//") return notRecognised;
-	const auto rvr = Distance::fromRvrString(match.str(matchRvr), unitFeet);
+	const auto runway = Runway::fromString(runwayStr);
+	if (!runway.has_value() && runwayStr != "R//") return notRecognised;
+	const auto rvr = Distance::fromRvrString(rvrStr, unitFeet);
 	if (!rvr.has_value()) return notRecognised;
 	VisibilityGroup result;
 	result.visType = Type::RVR;
 	result.rw = runway;
 	result.vis = *rvr;
-	result.rvrTrend = trendFromString(match.str(matchTrend));
-	if (match.length(matchVarRvr)) {
-		const auto varRvr = Distance::fromRvrString(match.str(matchVarRvr), unitFeet);
+	result.rvrTrend = trendFromString(trendStr);
+	if (!varRvrStr.empty()) {
+		const auto varRvr = Distance::fromRvrString(varRvrStr, unitFeet);
 		if (!varRvr.has_value()) return notRecognised;
 		result.visType = Type::VARIABLE_RVR;
 		result.visMax = *varRvr;
@@ -4892,7 +5994,7 @@ std::optional<VisibilityGroup> VisibilityGroup::fromRvr(const std::string & grou
 	return result;
 }
 
-bool VisibilityGroup::appendFractionToIncompleteInteger(const std::string & group,
+bool VisibilityGroup::appendFractionToIncompleteInteger(std::string_view group,
 	IncompleteText next)
 {
 	const auto v = Distance::fromMileString(group);
@@ -4905,7 +6007,7 @@ bool VisibilityGroup::appendFractionToIncompleteInteger(const std::string & grou
 }
 
 
-bool VisibilityGroup::appendDirection(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendDirection(std::string_view group, IncompleteText next) {
 	if (const auto d = Direction::fromCardinalString(group); d.has_value()) {
 		dir = d;
 		if (visType == Type::PREVAILING) visType = Type::DIRECTIONAL;
@@ -4922,7 +6024,7 @@ bool VisibilityGroup::appendDirection(const std::string & group, IncompleteText
 	return false;
 }
 
-bool VisibilityGroup::appendRunway(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendRunway(std::string_view group, IncompleteText next) {
 	const auto r = Runway::fromString(group, true);
 	if (!r.has_value()) return false;
 	rw = r;
@@ -4932,7 +6034,7 @@ bool VisibilityGroup::appendRunway(const std::string & group, IncompleteText nex
 	return true;
 }
 
-bool VisibilityGroup::appendInteger(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendInteger(std::string_view group, IncompleteText next) {
 	if (group.empty() || group.length() > 3) return false;
 	if (group.find('/') != std::string::npos) return false;
 	if (vis.isReported()) return false;
@@ -4943,7 +6045,7 @@ bool VisibilityGroup::appendInteger(const std::string & group, IncompleteText ne
 	return true;
 }
 
-bool VisibilityGroup::appendFraction(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendFraction(std::string_view group, IncompleteText next) {
 	if (group.find('/') == std::string::npos) return false;
 	const auto v = Distance::fromMileString(group, true);
 	if (!v.has_value()) return false;
@@ -4958,7 +6060,7 @@ bool VisibilityGroup::appendFraction(const std::string & group, IncompleteText n
 	return true;
 }
 
-bool VisibilityGroup::appendVariableMaxFraction(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendVariableMaxFraction(std::string_view group, IncompleteText next) {
 	const auto fraction = fractionStrToUint(group, 0, group.length());
 	if (!fraction.has_value()) return false;
 	const auto numerator = std::get<0>(*fraction);
@@ -4972,7 +6074,7 @@ bool VisibilityGroup::appendVariableMaxFraction(const std::string & group, Incom
 	return true;
 }
 
-bool VisibilityGroup::appendVariable(const std::string & group,
+bool VisibilityGroup::appendVariable(std::string_view group,
 	IncompleteText nextIfMaxIsInteger,
 	IncompleteText nextIfMaxIsFraction)
 {
@@ -5001,7 +6103,7 @@ bool VisibilityGroup::appendVariable(const std::string & group,
 	return true;
 }
 
-bool VisibilityGroup::appendMeters(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendMeters(std::string_view group, IncompleteText next) {
 	const auto v = Distance::fromMeterString(group);
 	if (!v.has_value()) return false;
 	if (!v->isReported()) return false;
@@ -5010,14 +6112,15 @@ bool VisibilityGroup::appendMeters(const std::string & group, IncompleteText nex
 	return true;
 }
 
-bool VisibilityGroup::appendVariableMeters(const std::string & group, IncompleteText next) {
-	static const std::regex rgx("(\\d\\d\\d\\d)V(\\d\\d\\d\\d)");
-	static const auto matchMin = 1, matchMax = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return false;
-	const auto min = Distance::fromMeterString(match.str(matchMin));
+bool VisibilityGroup::appendVariableMeters(std::string_view group, IncompleteText next) {
+	//static const std::regex rgx("(\\d\\d\\d\\d)V(\\d\\d\\d\\d)");
+	static const auto minPos = 0u, maxPos = 5u, visLen = 4u;
+	if (group.length() != maxPos + visLen || group[visLen] != 'V') return false;
+	if (!strToUint(group, minPos, visLen).has_value() ||
+		!strToUint(group, maxPos, visLen).has_value()) return false;
+	const auto min = Distance::fromMeterString(group.substr(minPos, visLen));
 	if (!min.has_value()) return false;
-	const auto max = Distance::fromMeterString(match.str(matchMax));
+	const auto max = Distance::fromMeterString(group.substr(maxPos, visLen));
 	if (!max.has_value()) return false;
 	if (!min->isReported() || !max->isReported()) return false;
 	vis = *min;
@@ -5027,7 +6130,7 @@ bool VisibilityGroup::appendVariableMeters(const std::string & group, Incomplete
 	return true;
 }
 
-VisibilityGroup::Trend VisibilityGroup::trendFromString(const std::string & s) {
+VisibilityGroup::Trend VisibilityGroup::trendFromString(std::string_view s) {
 	if (s == "/") return Trend::NOT_REPORTED;
 	if (s == "U") return Trend::UPWARD;
 	if (s == "N") return Trend::NEUTRAL;
@@ -5050,7 +6153,7 @@ bool VisibilityGroup::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<CloudGroup> CloudGroup::parse(const std::string & group,
+std::optional<CloudGroup> CloudGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5072,7 +6175,7 @@ std::optional<CloudGroup> CloudGroup::parse(const std::string & group,
 	return std::optional<CloudGroup>();
 }
 
-AppendResult CloudGroup::append(const std::string & group,
+AppendResult CloudGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5107,7 +6210,7 @@ AppendResult CloudGroup::append(const std::string & group,
 	}
 }
 
-std::optional<CloudGroup> CloudGroup::parseCloudLayerOrVertVis(const std::string & s) {
+std::optional<CloudGroup> CloudGroup::parseCloudLayerOrVertVis(std::string_view s) {
 	static const std::optional<CloudGroup> notRecognised;
 	// Attempt to parse 'no cloud' groups
 	if (s == "NCD") return CloudGroup(Type::NO_CLOUDS, Amount::NCD);
@@ -5115,17 +6218,31 @@ std::optional<CloudGroup> CloudGroup::parseCloudLayerOrVertVis(const std::string
 	if (s == "CLR") return CloudGroup(Type::NO_CLOUDS, Amount::NONE_CLR);
 	if (s == "SKC") return CloudGroup(Type::NO_CLOUDS, Amount::NONE_SKC);
 	//Attempt to parse cloud layer or vertical visibility
-	std::smatch match;
-	static const std::regex rgx(
-		"([A-Z][A-Z][A-Z]?|///)(\\d\\d\\d|///)([CT][BC][U]?|///)?");
-	static const auto matchAmount = 1, matchHeight = 2, matchCnvType = 3;
-	if (!std::regex_match(s, match, rgx)) return notRecognised;
+	//static const std::regex rgx(
+	//	"([A-Z][A-Z][A-Z]?|///)(\\d\\d\\d|///)([CT][BC][U]?|///)?");
+	if (s.length() < 5) return notRecognised;
+	std::size_t amountLen = 3;
+	if (s.substr(0, 3) != "///") {
+		if (!isUpperLetter(s[0]) || !isUpperLetter(s[1])) return notRecognised;
+		if (!isUpperLetter(s[2])) amountLen = 2;
+	}
+	static const auto heightLen = 3u;
+	const auto heightStr = s.substr(amountLen, heightLen);
+	if (heightStr != "///" && !strToUint(heightStr, 0, heightLen).has_value())
+		return notRecognised;
+	const auto cnvTypeStr = s.substr(amountLen + heightStr.length());
+	if (!cnvTypeStr.empty() && cnvTypeStr != "///") {
+		if (cnvTypeStr.length() < 2 || cnvTypeStr.length() > 3) return notRecognised;
+		if (cnvTypeStr[0] != 'C' && cnvTypeStr[0] != 'T') return notRecognised;
+		if (cnvTypeStr[1] != 'B' && cnvTypeStr[1] != 'C') return notRecognised;
+		if (cnvTypeStr.length() == 3 && cnvTypeStr[2] != 'U') return notRecognised;
+	}
 
-	const auto amount = amountFromString(match.str(matchAmount));
+	const auto amount = amountFromString(s.substr(0, amountLen));
 	if (!amount.has_value()) return notRecognised;
-	const auto height = Distance::fromHeightString(match.str(matchHeight));
+	const auto height = Distance::fromHeightString(heightStr);
 	if (!height.has_value()) return notRecognised;
-	const auto cnvtype = convectiveTypeFromString(match.str(matchCnvType));
+	const auto cnvtype = convectiveTypeFromString(cnvTypeStr);
 	if (!cnvtype.has_value()) return notRecognised;
 
 	// If vertical visibility is given, convective cloud type must not be specified
@@ -5141,24 +6258,29 @@ std::optional<CloudGroup> CloudGroup::parseCloudLayerOrVertVis(const std::string
 	return result;
 }
 
-std::optional<CloudGroup> CloudGroup::parseVariableCloudLayer(const std::string & s) {
+std::optional<CloudGroup> CloudGroup::parseVariableCloudLayer(std::string_view s) {
 	static const std::optional<CloudGroup> notRecognised;
 
-	std::smatch match;
-	static const std::regex rgx("([A-Z][A-Z][A-Z])(\\d\\d\\d)?");
-	static const auto matchAmount = 1, matchHeight = 2;
-	if (!std::regex_match(s, match, rgx)) return notRecognised;
+	//static const std::regex rgx("([A-Z][A-Z][A-Z])(\\d\\d\\d)?");
+	static const auto amountLen = 3u, heightLen = 3u;
+	if (s.length() != amountLen && s.length() != amountLen + heightLen)
+		return notRecognised;
+	for (auto i = 0u; i < amountLen; i++)
+		if (!isUpperLetter(s[i])) return notRecognised;
+	const auto heightStr = s.substr(amountLen);
+	if (!heightStr.empty() && !strToUint(heightStr, 0, heightLen).has_value())
+		return notRecognised;
 
 	CloudGroup result;
 	result.tp = Type::CLOUD_LAYER;
 	result.incompleteText = IncompleteText::RMK_AMOUNT;
 
-	const auto amount = amountFromString(match.str(matchAmount));
-	// Not checking for VV here because 3-char amount length guaranteed by regex
+	const auto amount = amountFromString(s.substr(0, amountLen));
+	// Not checking for VV here because 3-char amount length is checked above
 	if (!amount.has_value()) return notRecognised;
 	result.amnt = *amount;
 
-	if (const std::string heightStr = match.str(matchHeight); !heightStr.empty()) {
+	if (!heightStr.empty()) {
 		const auto height = Distance::fromHeightString(heightStr);
 		if (!height.has_value()) return notRecognised;
 		result.heightOrVertVis = *height;
@@ -5222,7 +6344,7 @@ std::optional<CloudType> CloudGroup::cloudType() const {
 	}
 }
 
-std::optional<CloudGroup::Amount> CloudGroup::amountFromString(const std::string & s) {
+std::optional<CloudGroup::Amount> CloudGroup::amountFromString(std::string_view s) {
 	if (s == "FEW") return CloudGroup::Amount::FEW;
 	if (s == "SCT") return CloudGroup::Amount::SCATTERED;
 	if (s == "BKN") return CloudGroup::Amount::BROKEN;
@@ -5233,7 +6355,7 @@ std::optional<CloudGroup::Amount> CloudGroup::amountFromString(const std::string
 }
 
 std::optional<CloudGroup::ConvectiveType> CloudGroup::convectiveTypeFromString(
-	const std::string & s)
+	std::string_view s)
 {
 	if (s.empty()) return ConvectiveType::NONE;
 	if (s == "TCU") return ConvectiveType::TOWERING_CUMULUS;
@@ -5242,7 +6364,7 @@ std::optional<CloudGroup::ConvectiveType> CloudGroup::convectiveTypeFromString(
 	return std::optional<ConvectiveType>();
 }
 
-AppendResult CloudGroup::appendVariableCloudAmount(const std::string & group) {
+AppendResult CloudGroup::appendVariableCloudAmount(std::string_view group) {
 	const auto newAmount = amountFromString(group);
 	if (!newAmount.has_value()) return AppendResult::GROUP_INVALIDATED;
 	const auto a1 = amount();
@@ -5257,20 +6379,23 @@ AppendResult CloudGroup::appendVariableCloudAmount(const std::string & group) {
 	return AppendResult::APPENDED;
 }
 
-AppendResult CloudGroup::appendCeiling(const std::string & group) {
+AppendResult CloudGroup::appendCeiling(std::string_view group) {
 	if (const auto d = Distance::fromHeightString(group); d.has_value()) {
 		if (!d->isReported()) return AppendResult::GROUP_INVALIDATED;
 		heightOrVertVis = *d;
 		incompleteText = IncompleteText::CIG_NUM;
 		return AppendResult::APPENDED;
 	}
-	static const std::regex rgx ("(\\d\\d\\d)V(\\d\\d\\d)");
-	static const auto matchMinHeight = 1, matchMaxHeight = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return AppendResult::GROUP_INVALIDATED;
-	const auto minH = Distance::fromHeightString(match.str(matchMinHeight));
+	//static const std::regex rgx ("(\\d\\d\\d)V(\\d\\d\\d)");
+	static const auto minPos = 0u, maxPos = 4u, heightLen = 3u;
+	if (group.length() != maxPos + heightLen || group[heightLen] != 'V')
+		return AppendResult::GROUP_INVALIDATED;
+	if (!strToUint(group, minPos, heightLen).has_value() ||
+		!strToUint(group, maxPos, heightLen).has_value())
+			return AppendResult::GROUP_INVALIDATED;
+	const auto minH = Distance::fromHeightString(group.substr(minPos, heightLen));
 	if (!minH.has_value()) return AppendResult::GROUP_INVALIDATED;
-	const auto maxH = Distance::fromHeightString(match.str(matchMaxHeight));
+	const auto maxH = Distance::fromHeightString(group.substr(maxPos, heightLen));
 	if (!maxH.has_value()) return AppendResult::GROUP_INVALIDATED;
 	heightOrVertVis = *minH;
 	maxHt = *maxH;
@@ -5279,7 +6404,7 @@ AppendResult CloudGroup::appendCeiling(const std::string & group) {
 	return AppendResult::APPENDED;
 }
 
-AppendResult CloudGroup::appendRunwayOrCardinalDirection(const std::string & group) {
+AppendResult CloudGroup::appendRunwayOrCardinalDirection(std::string_view group) {
 	incompleteText = IncompleteText::NONE;
 	rw = Runway::fromString(group, true);
 	if (rw.has_value()) return AppendResult::APPENDED;
@@ -5288,16 +6413,19 @@ AppendResult CloudGroup::appendRunwayOrCardinalDirection(const std::string & gro
 	return AppendResult::NOT_APPENDED;
 }
 
-AppendResult CloudGroup::appendObscuration(const std::string & group) {
-	static const std::regex rgx("([A-Z][A-Z][A-Z])(\\d\\d\\d)");
-	static const auto matchAmount = 1, matchHeight = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return AppendResult::GROUP_INVALIDATED;
+AppendResult CloudGroup::appendObscuration(std::string_view group) {
+	//static const std::regex rgx("([A-Z][A-Z][A-Z])(\\d\\d\\d)");
+	static const auto amountLen = 3u, heightLen = 3u;
+	if (group.length() != amountLen + heightLen) return AppendResult::GROUP_INVALIDATED;
+	for (auto i = 0u; i < amountLen; i++)
+		if (!isUpperLetter(group[i])) return AppendResult::GROUP_INVALIDATED;
+	if (!strToUint(group, amountLen, heightLen).has_value())
+		return AppendResult::GROUP_INVALIDATED;
 
-	const auto h = Distance::fromHeightString(match.str(matchHeight));
+	const auto h = Distance::fromHeightString(group.substr(amountLen, heightLen));
 	if (!h.has_value()) return AppendResult::GROUP_INVALIDATED;
 
-	const auto a = amountFromString(match.str(matchAmount));
+	const auto a = amountFromString(group.substr(0, amountLen));
 	if (!a.has_value()) return AppendResult::GROUP_INVALIDATED;
 
 	amnt = *a;
@@ -5309,7 +6437,7 @@ AppendResult CloudGroup::appendObscuration(const std::string & group) {
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<WeatherGroup> WeatherGroup::parse(const std::string & group,
+std::optional<WeatherGroup> WeatherGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5318,8 +6446,7 @@ std::optional<WeatherGroup> WeatherGroup::parse(const std::string & group,
 		if (group == "NSW") return WeatherGroup(Type::NSW);
 		if (const auto wp = parseWeatherWithoutEvent(group, reportPart); wp.has_value()) {
 			WeatherGroup result;
-			result.w[0] = *wp;
-			result.wsz = 1;
+			result.w.push_back(*wp);
 			if (wp->qualifier() == WeatherPhenomena::Qualifier::RECENT) result.t = Type::RECENT;
 			return result;
 		}
@@ -5335,7 +6462,7 @@ std::optional<WeatherGroup> WeatherGroup::parse(const std::string & group,
 	return notRecognised;
 }
 
-AppendResult WeatherGroup::append(const std::string & group,
+AppendResult WeatherGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5379,13 +6506,13 @@ AppendResult WeatherGroup::append(const std::string & group,
 
 inline std::vector<WeatherPhenomena> WeatherGroup::weatherPhenomena() const {
 	std::vector<WeatherPhenomena> result;
-	for (auto i=0u; i < wsz; i++)
+	for (auto i=0u; i < w.size(); i++)
 		result.push_back(w[i]);
 	return result;
 }
 
 std::optional<WeatherPhenomena> WeatherGroup::parseWeatherWithoutEvent(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart)
 {
 	std::optional<WeatherPhenomena> notRecognised;
@@ -5403,7 +6530,7 @@ std::optional<WeatherPhenomena> WeatherGroup::parseWeatherWithoutEvent(
 	return wp;
 }
 
-std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(const std::string & group,
+std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(std::string_view group,
 	const MetafTime & reportTime)
 {
 	std::optional<WeatherGroup> notRecognised;
@@ -5420,7 +6547,7 @@ std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(const std::string &
 			// i is the position after the last digit from eventStartPos
 			const auto eventLen = i - eventStartPos;
 			if (const auto minEventLen = 3; eventLen < minEventLen) return notRecognised;
-			const std::string s = group.substr(eventStartPos, eventLen);
+			const std::string_view s = group.substr(eventStartPos, eventLen);
 			const auto w =
 				WeatherPhenomena::fromWeatherBeginEndString(s, reportTime, previousWeather);
 			if (!w.has_value()) return notRecognised;
@@ -5431,7 +6558,7 @@ std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(const std::string &
 		lastDigit = currDigit;
 	}
 	// Last weather event in the string ends with a digit is not be detected in the loop
-	const std::string s = group.substr(eventStartPos);
+	const std::string_view s = group.substr(eventStartPos);
 	const auto w =
 		WeatherPhenomena::fromWeatherBeginEndString(s, reportTime, previousWeather);
 	if (!w.has_value()) return notRecognised;
@@ -5441,8 +6568,8 @@ std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(const std::string &
 
 
 bool WeatherGroup::addWeatherPhenomena(const WeatherPhenomena & wp) {
-	if (wsz >= wSize) return false;
-	w[wsz++] = wp;
+	if (w.size() >= wSize) return false;
+	w.push_back(wp);
 	return true;
 }
 
@@ -5462,25 +6589,42 @@ bool TemperatureGroup::isValid() const {
 	return (*airTemperature().temperature() >= *dewPoint().temperature());
 }
 
-std::optional<TemperatureGroup> TemperatureGroup::parse(const std::string & group,
+std::optional<TemperatureGroup> TemperatureGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	static const std::optional<TemperatureGroup> notRecognised;
-	static const std::regex rgx("(M?\\d\\d|//)/(M?\\d\\d|//)?");
-	static const auto matchTemperature = 1, matchDewPoint = 2;
-	static const std::regex rmkRgx("T([01]\\d\\d\\d)([01]\\d\\d\\d)?");
-	static const auto rmkMatchTemperature = 1, rmkMatchDewPoint = 2;
-	std::smatch match;
+	//static const std::regex rgx("(M?\\d\\d|//)/(M?\\d\\d|//)?");
+	//static const std::regex rmkRgx("T([01]\\d\\d\\d)([01]\\d\\d\\d)?");
+	// Temperature value is M?\\d\\d or //
+	const auto tempValueLength = [](std::string_view s, std::size_t pos) -> std::size_t {
+		if (pos > s.length()) return 0;
+		if (s.substr(pos, 2) == "//") return 2;
+		const std::size_t prefixLen = (pos < s.length() && s[pos] == 'M') ? 1 : 0;
+		if (!strToUint(s, pos + prefixLen, 2).has_value()) return 0;
+		return (prefixLen + 2);
+	};
+	// Remark temperature value is [01]\\d\\d\\d
+	const auto isRmkTempValue = [](std::string_view s, std::size_t pos) {
+		static const auto valueLen = 4u;
+		if (pos + valueLen > s.length()) return false;
+		if (s[pos] != '0' && s[pos] != '1') return false;
+		return strToUint(s, pos + 1, valueLen - 1).has_value();
+	};
 	if (reportPart == ReportPart::METAR) {
-		if (regex_match(group, match, rgx)) {
-			const auto t = Temperature::fromString(match.str(matchTemperature));
+		const auto tempLen = tempValueLength(group, 0);
+		const auto dewPointLen = tempValueLength(group, tempLen + 1);
+		if (tempLen &&
+			group.length() > tempLen && group[tempLen] == '/' &&
+			tempLen + 1 + dewPointLen == group.length())
+		{
+			const auto t = Temperature::fromString(group.substr(0, tempLen));
 			if (!t.has_value()) return notRecognised;
 			TemperatureGroup result(Type::TEMPERATURE_AND_DEW_POINT);
 			result.t = *t;
-			if (match.length(matchDewPoint)) {
-				const auto dp = Temperature::fromString(match.str(matchDewPoint));
+			if (dewPointLen) {
+				const auto dp = Temperature::fromString(group.substr(tempLen + 1));
 				if (!dp.has_value()) return notRecognised;
 				result.dp = *dp;
 			}
@@ -5490,13 +6634,20 @@ std::optional<TemperatureGroup> TemperatureGroup::parse(const std::string & grou
 	if (reportPart == ReportPart::RMK) {
 		if (group == "T") return TemperatureGroup(Type::T_MISG, true);
 		if (group == "TD") return TemperatureGroup(Type::TD_MISG, true);
-		if (regex_match(group, match, rmkRgx)) {
-			const auto t = Temperature::fromRemarkString(match.str(rmkMatchTemperature));
+		static const auto rmkTempPos = 1u, rmkDewPointPos = 5u, rmkValueLen = 4u;
+		if (group[0] == 'T' && isRmkTempValue(group, rmkTempPos) &&
+			(group.length() == rmkDewPointPos ||
+				(group.length() == rmkDewPointPos + rmkValueLen &&
+				isRmkTempValue(group, rmkDewPointPos))))
+		{
+			const auto t =
+				Temperature::fromRemarkString(group.substr(rmkTempPos, rmkValueLen));
 			if (!t.has_value()) return notRecognised;
 			TemperatureGroup result;
 			result.t = *t;
-			if (match.length(matchDewPoint)) {
-				const auto dp = Temperature::fromRemarkString(match.str(rmkMatchDewPoint));
+			if (group.length() > rmkDewPointPos) {
+				const auto dp = Temperature::fromRemarkString(
+					group.substr(rmkDewPointPos, rmkValueLen));
 				if (!dp.has_value()) return notRecognised;
 				result.dp = *dp;
 			}
@@ -5506,7 +6657,7 @@ std::optional<TemperatureGroup> TemperatureGroup::parse(const std::string & grou
 	return notRecognised;
 }
 
-AppendResult TemperatureGroup::append(const std::string & group,
+AppendResult TemperatureGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5521,7 +6672,7 @@ AppendResult TemperatureGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<PressureGroup> PressureGroup::parse(const std::string & group,
+std::optional<PressureGroup> PressureGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5565,7 +6716,7 @@ std::optional<PressureGroup> PressureGroup::parse(const std::string & group,
 	return notRecognised;
 }
 
-AppendResult PressureGroup::append(const std::string & group,
+AppendResult PressureGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5580,7 +6731,7 @@ AppendResult PressureGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<RunwayStateGroup> RunwayStateGroup::parse(const std::string & group,
+std::optional<RunwayStateGroup> RunwayStateGroup::parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata)
 {
@@ -5590,42 +6741,60 @@ std::optional<RunwayStateGroup> RunwayStateGroup::parse(const std::string & grou
 	if (reportPart != ReportPart::METAR) return notRecognised;
 	if (group == "SNOCLO" || group == "R/SNOCLO")
 		return RunwayStateGroup(Type::AERODROME_SNOCLO, Runway::makeAllRunways());
-	static const std::regex rgx("(R\\d\\d[RCL]?)/(?:"
-		"(SNOCLO)|"
-		"((\\d\\d)?D)|"
-		"(?:([0-9/])([0-9/])(\\d\\d|//)|(CLRD))(\\d\\d|//))|");
-	static const auto matchRunway = 1, matchSnoclo = 2;
-	static const auto matchClrdAvc = 3, matchFrictionAvc = 4;
-	static const auto matchDeposits = 5, matchExtent = 6, matchDepth = 7;
-	static const auto matchClrd = 8, matchFriction = 9;
-	static const std::string depthRunwayNotOperational = "99";
-	std::smatch match;
-	if (!regex_match(group, match, rgx)) return notRecognised;
-	const auto runway = Runway::fromString(match.str(matchRunway));
+	//static const std::regex rgx("(R\\d\\d[RCL]?)/(?:"
+	//	"(SNOCLO)|"
+	//	"((\\d\\d)?D)|"
+	//	"(?:([0-9/])([0-9/])(\\d\\d|//)|(CLRD))(\\d\\d|//))|");
+	static const std::string_view depthRunwayNotOperational = "99";
+	// Two-digit value which may be not reported (\\d\\d|//)
+	const auto isValueOrSlashes = [](std::string_view s) {
+		return (s == "//" || (s.length() == 2 && strToUint(s, 0, 2).has_value()));
+	};
+	const auto isDigitOrSlash = [](char c) { return (isDigit(c) || c == '/'); };
+	static const auto minRunwayLen = 3u;
+	if (group.length() < minRunwayLen + 1 || group[0] != 'R') return notRecognised;
+	if (!strToUint(group, 1, 2).has_value()) return notRecognised;
+	auto runwayLen = minRunwayLen;
+	if (group[runwayLen] == 'R' || group[runwayLen] == 'C' || group[runwayLen] == 'L')
+		runwayLen++;
+	if (runwayLen >= group.length() || group[runwayLen] != '/') return notRecognised;
+	const auto stateStr = group.substr(runwayLen + 1);
+	const auto runway = Runway::fromString(group.substr(0, runwayLen));
 	if (!runway.has_value()) return notRecognised;
-	if (match.length(matchSnoclo))
+	if (stateStr == "SNOCLO")
 		return RunwayStateGroup(Type::RUNWAY_SNOCLO, *runway);
-	if (match.length(matchClrdAvc)) {
+	if (stateStr == "D" ||
+		(stateStr.length() == 3 && stateStr[2] == 'D' && strToUint(stateStr, 0, 2).has_value()))
+	{
 		auto fr = SurfaceFriction();
-		if (match.length(matchFrictionAvc)) {
-			const auto f = SurfaceFriction::fromString(match.str(matchFrictionAvc));
+		if (stateStr.length() > 1) {
+			const auto f = SurfaceFriction::fromString(stateStr.substr(0, 2));
 			if (!f.has_value()) return notRecognised;
 			fr = *f;
 		}
 		return RunwayStateGroup(Type::RUNWAY_CLRD, *runway, fr);
 	}
-	const auto friction = SurfaceFriction::fromString(match.str(matchFriction));
+	static const auto stateLen = 6u, frictionPos = 4u, frictionLen = 2u;
+	if (stateStr.length() != stateLen) return notRecognised;
+	const auto frictionStr = stateStr.substr(frictionPos, frictionLen);
+	if (!isValueOrSlashes(frictionStr)) return notRecognised;
+	const bool clrd = (stateStr.substr(0, frictionPos) == "CLRD");
+	if (!clrd && (!isDigitOrSlash(stateStr[0]) ||
+		!isDigitOrSlash(stateStr[1]) ||
+		!isValueOrSlashes(stateStr.substr(2, 2)))) return notRecognised;
+	const auto friction = SurfaceFriction::fromString(frictionStr);
 	if (!friction.has_value()) return notRecognised;
-	if (match.length(matchClrd))
+	if (clrd)
 		return RunwayStateGroup(Type::RUNWAY_CLRD, *runway, *friction);
-	const auto deposits = depositsFromString(match.str(matchDeposits));
+	const auto deposits = depositsFromString(stateStr.substr(0, 1));
 	if (!deposits.has_value()) return notRecognised;
-	const auto extent = extentFromString(match.str(matchExtent));
+	const auto extent = extentFromString(stateStr.substr(1, 1));
 	if (!extent.has_value()) return notRecognised;
-	const auto depth = Precipitation::fromRunwayDeposits(match.str(matchDepth));
+	const auto depthStr = stateStr.substr(2, 2);
+	const auto depth = Precipitation::fromRunwayDeposits(depthStr);
 	if (!depth.has_value()) return notRecognised;
 	result.tp = Type::RUNWAY_STATE;
-	if (match.str(matchDepth) == depthRunwayNotOperational) {
+	if (depthStr == depthRunwayNotOperational) {
 		result.tp = Type::RUNWAY_NOT_OPERATIONAL;
 	}
 	result.rw = runway.value();
@@ -5636,7 +6805,7 @@ std::optional<RunwayStateGroup> RunwayStateGroup::parse(const std::string & grou
 	return result;
 }
 
-AppendResult RunwayStateGroup::append(const std::string & group,
+AppendResult RunwayStateGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5645,7 +6814,7 @@ AppendResult RunwayStateGroup::append(const std::string & group,
 }
 
 std::optional<RunwayStateGroup::Deposits> RunwayStateGroup::depositsFromString(
-	const std::string & s)
+	std::string_view s)
 {
 	std::optional<Deposits> error;
 	if (s.length() != 1) return error;
@@ -5666,7 +6835,7 @@ std::optional<RunwayStateGroup::Deposits> RunwayStateGroup::depositsFromString(
 }
 
 std::optional<RunwayStateGroup::Extent> RunwayStateGroup::extentFromString(
-	const std::string & s)
+	std::string_view s)
 {
 	std::optional<Extent> error;
 	if (s.length() != 1) return error;
@@ -5688,20 +6857,30 @@ std::optional<RunwayStateGroup::Extent> RunwayStateGroup::extentFromString(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<SeaSurfaceGroup> SeaSurfaceGroup::parse(const std::string & group,
+std::optional<SeaSurfaceGroup> SeaSurfaceGroup::parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	static const std::optional<SeaSurfaceGroup> notRecognised;
 	if (reportPart != ReportPart::METAR) return notRecognised;
-	static const std::regex rgx ("W(\\d\\d|//)/([HS](?:\\d\\d?\\d?|///|/))");
-	static const auto matchTemp = 1, matchWaveHeight = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	const auto temp = Temperature::fromString(match.str(matchTemp));
+	//static const std::regex rgx ("W(\\d\\d|//)/([HS](?:\\d\\d?\\d?|///|/))");
+	static const auto tempPos = 1u, tempLen = 2u, waveHeightPos = 4u;
+	if (group.length() <= waveHeightPos + 1) return notRecognised;
+	if (group[0] != 'W' || group[tempPos + tempLen] != '/') return notRecognised;
+	const auto tempStr = group.substr(tempPos, tempLen);
+	if (tempStr != "//" && !strToUint(tempStr, 0, tempLen).has_value())
+		return notRecognised;
+	const auto waveHeightStr = group.substr(waveHeightPos);
+	if (waveHeightStr[0] != 'H' && waveHeightStr[0] != 'S') return notRecognised;
+	if (const auto v = waveHeightStr.substr(1); v != "///" && v != "/") {
+		static const auto maxValueLen = 3u;
+		if (v.length() > maxValueLen || !strToUint(v, 0, v.length()).has_value())
+			return notRecognised;
+	}
+	const auto temp = Temperature::fromString(tempStr);
 	if (!temp.has_value()) return notRecognised;
-	const auto waveHeight = WaveHeight::fromString(match.str(matchWaveHeight));
+	const auto waveHeight = WaveHeight::fromString(waveHeightStr);
 	if (!waveHeight.has_value()) return notRecognised;
 	SeaSurfaceGroup result;
 	result.t = *temp;
@@ -5709,7 +6888,7 @@ std::optional<SeaSurfaceGroup> SeaSurfaceGroup::parse(const std::string & group,
 	return result;
 }
 
-AppendResult SeaSurfaceGroup::append(const std::string & group,
+AppendResult SeaSurfaceGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5720,7 +6899,7 @@ AppendResult SeaSurfaceGroup::append(const std::string & group,
 ///////////////////////////////////////////////////////////////////////////////
 
 std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5733,7 +6912,7 @@ std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::parse(
 	return std::optional<MinMaxTemperatureGroup>();
 }
 
-AppendResult MinMaxTemperatureGroup::append(const std::string & group,
+AppendResult MinMaxTemperatureGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5746,35 +6925,41 @@ AppendResult MinMaxTemperatureGroup::append(const std::string & group,
 }
 
 std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::from6hourly(
-	const std::string & group)
+	std::string_view group)
 {
 	std::optional<MinMaxTemperatureGroup> notRecognised;
-	static const std::regex rgx("([12])([01]\\d\\d\\d|////)");
-	static const auto matchType = 1, matchValue = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
+	//static const std::regex rgx("([12])([01]\\d\\d\\d|////)");
+	static const auto valuePos = 1u, valueLen = 4u;
+	if (group.length() != valuePos + valueLen) return notRecognised;
+	const auto typeChar = group[0];
+	if (typeChar != '1' && typeChar != '2') return notRecognised;
+	const auto valueStr = group.substr(valuePos, valueLen);
+	if (valueStr != "////" && ((valueStr[0] != '0' && valueStr[0] != '1') ||
+		!strToUint(valueStr, 1, valueLen - 1).has_value())) return notRecognised;
 	MinMaxTemperatureGroup result;
 	result.t = Type::OBSERVED_6_HOURLY;
-	if (match.str(matchValue) == "////") return result;
-	const auto temp = Temperature::fromRemarkString(match.str(matchValue));
+	if (valueStr == "////") return result;
+	const auto temp = Temperature::fromRemarkString(valueStr);
 	if (!temp.has_value()) return notRecognised;
-	const auto typeStr = match.str(matchType);
-	if (typeStr == "1") { result.maxTemp = *temp; }
-	if (typeStr == "2") { result.minTemp = *temp; }
+	if (typeChar == '1') { result.maxTemp = *temp; }
+	if (typeChar == '2') { result.minTemp = *temp; }
 	return result;
 }
 
 std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::from24hourly(
-	const std::string & group)
+	std::string_view group)
 {
 	std::optional<MinMaxTemperatureGroup> notRecognised;
-	static const std::regex rgx("4([01]\\d\\d\\d)([01]\\d\\d\\d)");
-	static const auto matchMax = 1, matchMin = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	const auto max = Temperature::fromRemarkString(match.str(matchMax));
+	//static const std::regex rgx("4([01]\\d\\d\\d)([01]\\d\\d\\d)");
+	static const auto maxPos = 1u, minPos = 5u, valueLen = 4u;
+	if (group.length() != minPos + valueLen || group[0] != '4') return notRecognised;
+	if (group[maxPos] != '0' && group[maxPos] != '1') return notRecognised;
+	if (group[minPos] != '0' && group[minPos] != '1') return notRecognised;
+	if (!strToUint(group, maxPos + 1, valueLen - 1).has_value() ||
+		!strToUint(group, minPos + 1, valueLen - 1).has_value()) return notRecognised;
+	const auto max = Temperature::fromRemarkString(group.substr(maxPos, valueLen));
 	if (!max.has_value()) return notRecognised;
-	const auto min = Temperature::fromRemarkString(match.str(matchMin));
+	const auto min = Temperature::fromRemarkString(group.substr(minPos, valueLen));
 	if (!min.has_value()) return notRecognised;
 	MinMaxTemperatureGroup result;
 	result.t = Type::OBSERVED_24_HOURLY;
@@ -5784,28 +6969,35 @@ std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::from24hourly(
 }
 
 std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::fromForecast(
-	const std::string & group)
+	std::string_view group)
 {
 	static const std::optional<MinMaxTemperatureGroup> notRecognised;
-	static const std::regex rgx ("T([XN])?(M?\\d\\d)/(\\d\\d\\d\\d)Z");
-	static const auto matchPoint = 1, matchTemperature = 2, matchTime = 3;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	auto temp = Temperature::fromString(match.str(matchTemperature));
+	//static const std::regex rgx ("T([XN])?(M?\\d\\d)/(\\d\\d\\d\\d)Z");
+	if (group.length() < 3 || group[0] != 'T') return notRecognised;
+	char point = '\0';
+	std::size_t tempPos = 1;
+	if (group[tempPos] == 'X' || group[tempPos] == 'N') point = group[tempPos++];
+	const std::size_t tempLen = (group[tempPos] == 'M') ? 3 : 2;
+	static const auto timeLen = 4u;
+	const auto timePos = tempPos + tempLen + 1;
+	if (group.length() != timePos + timeLen + 1) return notRecognised;
+	if (!strToUint(group, timePos - 3, 2).has_value()) return notRecognised;
+	if (group[timePos - 1] != '/' || group[timePos + timeLen] != 'Z') return notRecognised;
+	auto temp = Temperature::fromString(group.substr(tempPos, tempLen));
 	if (!temp.has_value()) return notRecognised;
-	auto time = MetafTime::fromStringDDHH(match.str(matchTime));
+	auto time = MetafTime::fromStringDDHH(group.substr(timePos, timeLen));
 	if (!time.has_value()) return notRecognised;
 	MinMaxTemperatureGroup result;
 	result.t = Type::FORECAST;
-	if (match.str(matchPoint) == "N") {
+	if (point == 'N') {
 		result.minTemp = *temp;
 		result.minTime = time;
 	}
-	if (match.str(matchPoint) == "X") {
+	if (point == 'X') {
 		result.maxTemp = *temp;
 		result.maxTime = time;
 	}
-	if (!match.length(matchPoint)) {
+	if (!point) {
 		result.minTemp = *temp;
 		result.minTime = time;
 		result.maxTemp = *temp;
@@ -5815,7 +7007,7 @@ std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::fromForecast(
 	return result;
 }
 
-AppendResult MinMaxTemperatureGroup::append6hourly(const std::string & group) {
+AppendResult MinMaxTemperatureGroup::append6hourly(std::string_view group) {
 	static const auto error = AppendResult::NOT_APPENDED;
 	if (minTemp.isReported() && maxTemp.isReported()) return error;
 	const auto nextGroup = from6hourly(group);
@@ -5827,7 +7019,7 @@ AppendResult MinMaxTemperatureGroup::append6hourly(const std::string & group) {
 	return AppendResult::APPENDED;
 }
 
-AppendResult MinMaxTemperatureGroup::appendForecast(const std::string & group) {
+AppendResult MinMaxTemperatureGroup::appendForecast(std::string_view group) {
 	static const auto error = AppendResult::NOT_APPENDED;
 	if (minTemp.isReported() && maxTemp.isReported() && !isIncomplete) return error;
 	const auto nextGroup = fromForecast(group);
@@ -5875,30 +7067,46 @@ bool MinMaxTemperatureGroup::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<PrecipitationGroup> PrecipitationGroup::parse(const std::string & group,
+std::optional<PrecipitationGroup> PrecipitationGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	std::optional<PrecipitationGroup> notRecognised;
-	static const std::regex rgx(
-		"([P67])(\\d\\d\\d\\d|////)|(4/|93[13]|I[136]|PP)(\\d\\d\\d|///)");
-	static const auto matchType1 = 1, matchType2 = 3;
-	static const auto matchValue1 = 2, matchValue2 = 4;
-
-	static const std::regex rfRgx (
-		"RF(\\d\\d\\.\\d|//\\./)/(\\d\\d\\d\\.\\d|///\\./)");
-	static const auto rfMatchLast10Minutes = 1, rfMatchSince9AM = 2;
+	//static const std::regex rgx(
+	//	"([P67])(\\d\\d\\d\\d|////)|(4/|93[13]|I[136]|PP)(\\d\\d\\d|///)");
+	//static const std::regex rfRgx (
+	//	"RF(\\d\\d\\.\\d|//\\./)/(\\d\\d\\d\\.\\d|///\\./)");
+
+	// Value is either all digits or all slashes
+	const auto isValue = [](std::string_view s, std::size_t len) {
+		if (s.length() != len) return false;
+		if (s.find_first_not_of('/') == std::string_view::npos) return true;
+		return strToUint(s, 0, len).has_value();
+	};
+	// Rainfall value is digits followed by decimal point and one digit, or
+	// the same pattern with all digits replaced by slashes
+	const auto isRainfallValue = [&](std::string_view s, std::size_t intLen) {
+		if (s.length() != intLen + 2 || s[intLen] != '.') return false;
+		const auto fractionStr = s.substr(intLen + 1);
+		if (fractionStr == "/") return (s.find_first_not_of('/') == intLen);
+		return (strToUint(s, 0, intLen).has_value() && isDigit(fractionStr[0]));
+	};
 
-	std::smatch match;
 	PrecipitationGroup result;
 
 	if (reportPart == ReportPart::METAR) {
-		if (!std::regex_match(group, match, rfRgx)) return notRecognised;
-		const auto last10min =
-			Precipitation::fromRainfallString(match.str(rfMatchLast10Minutes));
+		static const auto last10minPos = 2u, since9AMPos = 7u;
+		static const auto last10minIntLen = 2u, since9AMIntLen = 3u;
+		if (group.length() != since9AMPos + since9AMIntLen + 2 ||
+			group.substr(0, last10minPos) != "RF" ||
+			group[since9AMPos - 1] != '/') return notRecognised;
+		const auto last10minStr = group.substr(last10minPos, last10minIntLen + 2);
+		const auto since9AMStr = group.substr(since9AMPos);
+		if (!isRainfallValue(last10minStr, last10minIntLen) ||
+			!isRainfallValue(since9AMStr, since9AMIntLen)) return notRecognised;
+		const auto last10min = Precipitation::fromRainfallString(last10minStr);
 		if (!last10min.has_value()) return notRecognised;
-		const auto since9AM =
-			Precipitation::fromRainfallString(match.str(rfMatchSince9AM));
+		const auto since9AM = Precipitation::fromRainfallString(since9AMStr);
 		if (!since9AM.has_value()) return notRecognised;
 		result.precType = Type::RAINFALL_9AM_10MIN;
 		result.precAmount = *since9AM;
@@ -5914,11 +7122,29 @@ std::optional<PrecipitationGroup> PrecipitationGroup::parse(const std::string &
 	if (group == "PCPN") return PrecipitationGroup(Type::PCPN_MISG, true);
 	if (group == "SNINCR") return PrecipitationGroup(Type::SNOW_INCREASING_RAPIDLY);
 
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-
-	// assuming only one pair matchType and matchValue will be non-empty
-	std::string typeStr = match.str(matchType1) + match.str(matchType2);
-	std::string valueStr = match.str(matchValue1) + match.str(matchValue2);
+	std::string_view typeStr, valueStr;
+	static const auto longValueLen = 4u, shortValueLen = 3u;
+	if (group.length() == 1 + longValueLen &&
+		(group[0] == 'P' || group[0] == '6' || group[0] == '7') &&
+		isValue(group.substr(1), longValueLen))
+	{
+		typeStr = group.substr(0, 1);
+		valueStr = group.substr(1);
+	} else {
+		static const std::string_view shortValueTypes[] =
+			{"4/", "931", "933", "I1", "I3", "I6", "PP"};
+		for (const auto t : shortValueTypes) {
+			if (group.length() == t.length() + shortValueLen &&
+				group.substr(0, t.length()) == t &&
+				isValue(group.substr(t.length()), shortValueLen))
+			{
+				typeStr = t;
+				valueStr = group.substr(t.length());
+				break;
+			}
+		}
+	}
+	if (typeStr.empty()) return notRecognised;
 
 	const bool is3hourly =
 		reportMetadata.reportTime.has_value() ?
@@ -5954,7 +7180,7 @@ std::optional<PrecipitationGroup> PrecipitationGroup::parse(const std::string &
 	return result;
 }
 
-AppendResult PrecipitationGroup::append(const std::string & group,
+AppendResult PrecipitationGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6010,7 +7236,7 @@ float PrecipitationGroup::factorFromType(Type type) {
 ///////////////////////////////////////////////////////////////////////////////
 
 std::optional<LayerForecastGroup::Type> LayerForecastGroup::typeFromStr(
-	const std::string & s)
+	std::string_view s)
 {
 	if (s == "60") return Type::ICING_TRACE_OR_NONE;
 	if (s == "61") return Type::ICING_LIGHT_MIXED;
@@ -6037,32 +7263,36 @@ std::optional<LayerForecastGroup::Type> LayerForecastGroup::typeFromStr(
 }
 
 std::optional<LayerForecastGroup> LayerForecastGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	std::optional<LayerForecastGroup> notRecognised;
-	static const std::regex rgx("([65][\\dX])(\\d\\d\\d\\d|////)");
-	static const auto matchType = 1, matchHeight = 2;
+	//static const std::regex rgx("([65][\\dX])(\\d\\d\\d\\d|////)");
+	static const auto typeLen = 2u, heightLen = 4u;
 
 	if (reportPart != ReportPart::TAF) return notRecognised;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	const auto type = typeFromStr(match.str(matchType));
+	if (group.length() != typeLen + heightLen) return notRecognised;
+	if (group[0] != '6' && group[0] != '5') return notRecognised;
+	if (!isDigit(group[1]) && group[1] != 'X') return notRecognised;
+	const auto heightStr = group.substr(typeLen);
+	if (heightStr != "////" && !strToUint(heightStr, 0, heightLen).has_value())
+		return notRecognised;
+	const auto type = typeFromStr(group.substr(0, typeLen));
 	if (!type.has_value()) return notRecognised;
-	const auto heights = Distance::fromLayerString(match.str(matchHeight));
-	if (!heights.has_value() && match.str(matchHeight) != "////") return notRecognised;
+	const auto heights = Distance::fromLayerString(heightStr);
+	if (!heights.has_value() && heightStr != "////") return notRecognised;
 	LayerForecastGroup result;
 	result.layerType = *type;
-	if (match.str(matchHeight) != "////") {
+	if (heightStr != "////") {
 		result.layerBaseHeight = std::get<0>(*heights);
 		result.layerTopHeight = std::get<1>(*heights);
 	}
 	return result;
 }
 
-AppendResult LayerForecastGroup::append(const std::string & group,
+AppendResult LayerForecastGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6119,7 +7349,7 @@ std::optional<PressureTendencyGroup::Type> PressureTendencyGroup::typeFromChar(
 }
 
 std::optional<PressureTendencyGroup> PressureTendencyGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6139,14 +7369,16 @@ std::optional<PressureTendencyGroup> PressureTendencyGroup::parse(
 		return result;
 	}
 
-	static const std::regex rgx("5([\\d/])(\\d\\d\\d|///)");
-	static const auto matchType = 1, matchPressure = 2;
-
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	const auto type = typeFromChar(match.str(matchType)[0]);
+	//static const std::regex rgx("5([\\d/])(\\d\\d\\d|///)");
+	static const auto pressurePos = 2u, pressureLen = 3u;
+	if (group.length() != pressurePos + pressureLen || group[0] != '5') return notRecognised;
+	if (!isDigit(group[1]) && group[1] != '/') return notRecognised;
+	const auto pressureStr = group.substr(pressurePos);
+	if (pressureStr != "///" && !strToUint(pressureStr, 0, pressureLen).has_value())
+		return notRecognised;
+	const auto type = typeFromChar(group[1]);
 	if (!type.has_value()) return notRecognised;
-	const auto pressure = Pressure::fromTendencyString(match.str(matchPressure));
+	const auto pressure = Pressure::fromTendencyString(pressureStr);
 	if (!pressure.has_value()) return notRecognised;
 
 	PressureTendencyGroup result;
@@ -6155,7 +7387,7 @@ std::optional<PressureTendencyGroup> PressureTendencyGroup::parse(
 	return result;
 }
 
-AppendResult PressureTendencyGroup::append(const std::string & group,
+AppendResult PressureTendencyGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6167,58 +7399,72 @@ AppendResult PressureTendencyGroup::append(const std::string & group,
 
 std::vector<CloudType> CloudTypesGroup::cloudTypes() const {
 	std::vector<CloudType> result;
-	for (auto i=0u; i < cldTpSize; i++)
+	for (auto i=0u; i < cldTp.size(); i++)
 		result.push_back(cldTp[i]);
 	return result;
 }
 
-std::optional<CloudTypesGroup> CloudTypesGroup::parse(const std::string & group,
+std::optional<CloudTypesGroup> CloudTypesGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	std::optional<CloudTypesGroup> notRecognised;
 	//"(CB|TCU|CU|CF|SC|NS|ST|SF|AS|AC|ACC|CI|CS|CC|BLSN|BLDU|BLSA|IC|)(\\d)"
-	static const std::regex matchRgx("(?:(?:[A-Z]{2,4})[\\d])+");
-	static const std::regex searchRgx("[A-Z]{2,4}[\\d]");
+	//static const std::regex matchRgx("(?:(?:[A-Z]{2,4})[\\d])+");
+	//static const std::regex searchRgx("[A-Z]{2,4}[\\d]");
 
 	if (reportPart != ReportPart::RMK) return notRecognised;
-	std::smatch match;
 	CloudTypesGroup result;
 
 	if (const auto ctp = CloudType::fromString(group); ctp.has_value()) {
-		result.cldTp[0] = *ctp;
-		result.cldTpSize = 1;
+		result.cldTp.push_back(*ctp);
 		return result;
 	}
-	if (!std::regex_match(group, match, matchRgx)) return notRecognised;
-	auto iter = std::sregex_iterator(group.begin(), group.end(), searchRgx);
-	while (iter != std::sregex_iterator()) {
-		if (result.cldTpSize >= result.cldTpMaxSize) return result;
-		match = *iter++;
-		const auto ctp = CloudType::fromString(match.str(0));
+	// Length of the cloud type and okta unit (2 to 4 letters followed by
+	// a digit) starting at pos, or zero if there is no such unit at pos
+	const auto unitLength = [](std::string_view s, std::size_t pos) -> std::size_t {
+		static const auto minLetters = 2u, maxLetters = 4u;
+		auto letters = 0u;
+		while (pos + letters < s.length() && isUpperLetter(s[pos + letters]))
+			letters++;
+		if (letters < minLetters || letters > maxLetters) return 0;
+		if (pos + letters >= s.length() || !isDigit(s[pos + letters])) return 0;
+		return (letters + 1);
+	};
+	if (group.empty()) return notRecognised;
+	for (auto pos = 0u; pos < group.length();) {
+		const auto len = unitLength(group, pos);
+		if (!len) return notRecognised;
+		pos += len;
+	}
+	for (auto pos = 0u; pos < group.length();) {
+		if (result.cldTp.size() >= result.cldTpMaxSize) return result;
+		const auto len = unitLength(group, pos);
+		const auto ctp = CloudType::fromString(group.substr(pos, len));
 		if (!ctp.has_value()) return notRecognised;
-		result.cldTp[result.cldTpSize++] = *ctp;
+		result.cldTp.push_back(*ctp);
+		pos += len;
 	}
 	return result;
 }
 
-AppendResult CloudTypesGroup::append(const std::string & group,
+AppendResult CloudTypesGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata; (void)group; (void)reportPart;
-	if (cldTpSize >= cldTpMaxSize) return AppendResult::NOT_APPENDED;
-	if (!cldTp[cldTpSize - 1].height().isReported()) return AppendResult::NOT_APPENDED;
+	if (cldTp.size() >= cldTpMaxSize) return AppendResult::NOT_APPENDED;
+	if (!cldTp[cldTp.size() - 1].height().isReported()) return AppendResult::NOT_APPENDED;
 	const auto ctp = CloudType::fromString(group);
 	if (!ctp.has_value()) return AppendResult::NOT_APPENDED;
 	if (!ctp->height().isReported()) return AppendResult::NOT_APPENDED;
-	cldTp[cldTpSize++] = *ctp;
+	cldTp.push_back(*ctp);
 	return AppendResult::APPENDED;
 }
 
 bool CloudTypesGroup::isValid() const {
-	for (auto i=0u; i < cldTpSize; i++)
+	for (auto i=0u; i < cldTp.size(); i++)
 		if (!cldTp[i].isValid()) return false;
 	return true;
 }
@@ -6234,22 +7480,24 @@ bool LowMidHighCloudGroup::isValid() const {
 }
 
 
-std::optional<LowMidHighCloudGroup> LowMidHighCloudGroup::parse(const std::string & group,
+std::optional<LowMidHighCloudGroup> LowMidHighCloudGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	std::optional<LowMidHighCloudGroup> notRecognised;
-	static const std::regex rgx("8/([0-9/])([0-9/])([0-9/])");
-	static const auto matchLowLayer = 1, matchMidLayer = 2, matchHighLayer = 3;
+	//static const std::regex rgx("8/([0-9/])([0-9/])([0-9/])");
+	static const auto lowLayerPos = 2u, midLayerPos = 3u, highLayerPos = 4u;
 
 	if (reportPart != ReportPart::RMK) return notRecognised;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-
-	const auto lowLayer = lowLayerFromChar(match.str(matchLowLayer)[0]);
-	const auto midLayer = midLayerFromChar(match.str(matchMidLayer)[0]);
-	const auto highLayer = highLayerFromChar(match.str(matchHighLayer)[0]);
+	if (group.length() != highLayerPos + 1) return notRecognised;
+	if (group[0] != '8' || group[1] != '/') return notRecognised;
+	for (auto i = lowLayerPos; i <= highLayerPos; i++)
+		if (!isDigit(group[i]) && group[i] != '/') return notRecognised;
+
+	const auto lowLayer = lowLayerFromChar(group[lowLayerPos]);
+	const auto midLayer = midLayerFromChar(group[midLayerPos]);
+	const auto highLayer = highLayerFromChar(group[highLayerPos]);
 	LowMidHighCloudGroup result;
 	result.cloudLowLayer = lowLayer;
 	result.cloudMidLayer = midLayer;
@@ -6257,7 +7505,7 @@ std::optional<LowMidHighCloudGroup> LowMidHighCloudGroup::parse(const std::strin
 	return result;
 }
 
-AppendResult LowMidHighCloudGroup::append(const std::string & group,
+AppendResult LowMidHighCloudGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6316,7 +7564,7 @@ LowMidHighCloudGroup::HighLayer LowMidHighCloudGroup::highLayerFromChar(char c)
 ///////////////////////////////////////////////////////////////////////////////
 
 std::optional<LightningGroup> LightningGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6328,7 +7576,7 @@ std::optional<LightningGroup> LightningGroup::parse(
 	return fromLtgGroup(group);
 }
 
-AppendResult LightningGroup::append(const std::string & group,
+AppendResult LightningGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6381,7 +7629,7 @@ AppendResult LightningGroup::append(const std::string & group,
 	return AppendResult::NOT_APPENDED;
 }
 
-std::optional<LightningGroup> LightningGroup::fromLtgGroup(const std::string & group) {
+std::optional<LightningGroup> LightningGroup::fromLtgGroup(std::string_view group) {
 	std::optional<LightningGroup> notRecognised;
 	static const auto ltgLen = 3u; // length of string LTG
 	static const char ltg[ltgLen + 1] = "LTG";
@@ -6432,7 +7680,7 @@ std::vector<Direction> LightningGroup::directions() const {
 ///////////////////////////////////////////////////////////////////////////////
 
 std::optional<VicinityGroup> VicinityGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6461,7 +7709,7 @@ std::optional<VicinityGroup> VicinityGroup::parse(
 	return notRecognised;
 }
 
-AppendResult VicinityGroup::append(const std::string & group,
+AppendResult VicinityGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6509,7 +7757,7 @@ AppendResult VicinityGroup::append(const std::string & group,
 	}
 }
 
-bool VicinityGroup::appendDir1(const std::string & str) {
+bool VicinityGroup::appendDir1(std::string_view str) {
 	if (const auto dir = Direction::fromCardinalString(str, true); dir.has_value()) {
 		//Single direction is specified
 		dir1from = *dir;
@@ -6524,7 +7772,7 @@ bool VicinityGroup::appendDir1(const std::string & str) {
 	return false;
 }
 
-bool VicinityGroup::appendDir2(const std::string & str) {
+bool VicinityGroup::appendDir2(std::string_view str) {
 	if (const auto dir = Direction::fromCardinalString(str, true); dir.has_value()) {
 		//Single direction is specified
 		dir2from = *dir;
@@ -6539,7 +7787,7 @@ bool VicinityGroup::appendDir2(const std::string & str) {
 	return false;
 }
 
-bool VicinityGroup::appendDistance(const std::string & str) {
+bool VicinityGroup::appendDistance(std::string_view str) {
 	if (str == "DSNT") { dist = Distance::makeDistant(); return true; }
 	if (str == "VC") { dist = Distance::makeVicinity(); return true; }
 	const auto d = Distance::fromKmString(str);
@@ -6568,18 +7816,15 @@ std::vector<Direction> VicinityGroup::directions() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<MiscGroup> MiscGroup::parse(const std::string & group,
+std::optional<MiscGroup> MiscGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
-	static const std::regex rgxSunshineDuration("98(\\d\\d\\d)");
-	static const std::regex rgxCorrectionObservation("CC([A-Z])");
-	static const auto matchValue = 1;
-	static const std::regex rgxIssuerId("F([NS])(\\d\\d\\d\\d\\d)");
-	static const auto matchIssuerStation = 1, matchIssuerId = 2;
+	//static const std::regex rgxSunshineDuration("98(\\d\\d\\d)");
+	//static const std::regex rgxCorrectionObservation("CC([A-Z])");
+	//static const std::regex rgxIssuerId("F([NS])(\\d\\d\\d\\d\\d)");
 
-	std::smatch match;
 	MiscGroup result;
 
 	if (reportPart == ReportPart::METAR || reportPart == ReportPart::RMK) {
@@ -6590,18 +7835,25 @@ std::optional<MiscGroup> MiscGroup::parse(const std::string & group,
 	}
 
 	if (reportPart == ReportPart::TAF) {
-		if (std::regex_match(group, match, rgxIssuerId)) {
-			result.groupType = Type::ISSUER_ID_FS;
-			if (match.str(matchIssuerStation) == "N") result.groupType = Type::ISSUER_ID_FN;
-			result.groupData = std::stoi(match.str(matchIssuerId));
-			return result;
+		static const auto issuerIdPos = 2u, issuerIdLen = 5u;
+		if (group.length() == issuerIdPos + issuerIdLen && group[0] == 'F' &&
+			(group[1] == 'N' || group[1] == 'S'))
+		{
+			if (const auto id = strToUint(group, issuerIdPos, issuerIdLen); id.has_value()) {
+				result.groupType = Type::ISSUER_ID_FS;
+				if (group[1] == 'N') result.groupType = Type::ISSUER_ID_FN;
+				result.groupData = *id;
+				return result;
+			}
 		}
 	}
 
 	if (reportPart == ReportPart::METAR) {
-		if (std::regex_match(group, match, rgxCorrectionObservation)) {
+		if (group.length() == 3 && group[0] == 'C' && group[1] == 'C' &&
+			isUpperLetter(group[2]))
+		{
 			result.groupType = Type::CORRECTED_WEATHER_OBSERVATION;
-			result.groupData = match.str(matchValue)[0] - 'A' + 1;
+			result.groupData = group[2] - 'A' + 1;
 			return result;
 		}
 	}
@@ -6617,10 +7869,15 @@ std::optional<MiscGroup> MiscGroup::parse(const std::string & group,
 			result.incompleteText = IncompleteText::DENSITY;
 			return result;
 		}
-		if (std::regex_match(group, match, rgxSunshineDuration)) {
-			result.groupType = Type::SUNSHINE_DURATION_MINUTES;
-			result.groupData = std::stoi(match.str(matchValue));
-			return result;
+		static const auto sunshinePos = 2u, sunshineLen = 3u;
+		if (group.length() == sunshinePos + sunshineLen &&
+			group[0] == '9' && group[1] == '8')
+		{
+			if (const auto d = strToUint(group, sunshinePos, sunshineLen); d.has_value()) {
+				result.groupType = Type::SUNSHINE_DURATION_MINUTES;
+				result.groupData = *d;
+				return result;
+			}
 		}
 		if (group == "FROIN") {
 			result.groupType = Type::FROIN;
@@ -6631,7 +7888,7 @@ std::optional<MiscGroup> MiscGroup::parse(const std::string & group,
 	return std::optional<MiscGroup>();
 }
 
-AppendResult MiscGroup::append(const std::string & group,
+AppendResult MiscGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6671,7 +7928,7 @@ AppendResult MiscGroup::append(const std::string & group,
 	}
 }
 
-std::optional<MiscGroup::Type> MiscGroup::parseColourCode(const std::string & group) {
+std::optional<MiscGroup::Type> MiscGroup::parseColourCode(std::string_view group) {
 	if (group == "BLU+") return Type::COLOUR_CODE_BLUE_PLUS;
 	if (group == "BLU") return Type::COLOUR_CODE_BLUE;
 	if (group == "WHT") return Type::COLOUR_CODE_WHITE;
@@ -6693,7 +7950,7 @@ std::optional<MiscGroup::Type> MiscGroup::parseColourCode(const std::string & gr
 	return std::optional<Type>();
 }
 
-bool MiscGroup::appendHailstoneFraction(const std::string & group) {
+bool MiscGroup::appendHailstoneFraction(std::string_view group) {
 	// Fraction specified with increment of 1/4
 	bool appended = false;
 	auto value = groupData.value_or(0.0);
@@ -6706,7 +7963,7 @@ bool MiscGroup::appendHailstoneFraction(const std::string & group) {
 	return true;
 }
 
-bool MiscGroup::appendDensityAltitude(const std::string & group) {
+bool MiscGroup::appendDensityAltitude(std::string_view group) {
 	static const std::string unitStr ("FT");
 	static const auto unitLen = unitStr.length();
 	if (group.length() < unitLen + 1) return false; //require at least 1 digit and FT
@@ -6725,7 +7982,8 @@ bool MiscGroup::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SyntaxGroup getSyntaxGroup(const Group & group) {
+template <typename G>
+SyntaxGroup getSyntaxGroup(const G & group) {
 	if (auto keywordGroup = std::get_if<KeywordGroup>(&group)) {
 		switch (keywordGroup->type()) {
 			case KeywordGroup::Type::METAR:	return SyntaxGroup::METAR;
@@ -6754,63 +8012,537 @@ SyntaxGroup getSyntaxGroup(const Group & group) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-ParseResult Parser::parse(const std::string & report, size_t groupLimit) {
-	ReportInput in(report);
+template <typename Allocator, typename G>
+void BasicParserContext<Allocator, G>::reserve(size_t groupCount) {
+	parseResult.groups.reserve(groupCount);
+	rawStringPool.reserve(groupCount);
+}
+
+template <typename Allocator, typename G>
+void BasicParserContext<Allocator, G>::clear() {
+	for (auto & groupInfo : parseResult.groups)
+		recycle(std::move(groupInfo.rawString));
+	parseResult.groups.clear();
+	report = std::string_view();
+	lastDecoded = DecodedGroup();
+	steps = 0;
+}
+
+template <typename Allocator, typename G>
+typename BasicParserContext<Allocator, G>::String
+	BasicParserContext<Allocator, G>::rawString(std::string_view s)
+{
+	if constexpr (isSpanMode) {
+		if (s.empty()) return ReportSpan();
+		ReportSpan span;
+		span.offset = static_cast<uint32_t>(s.data() - report.data());
+		span.length = static_cast<uint32_t>(s.length());
+		return span;
+	} else {
+		if (rawStringPool.empty()) return String(s, allocator);
+		String result = std::move(rawStringPool.back());
+		rawStringPool.pop_back();
+		result.assign(s);
+		return result;
+	}
+}
+
+template <typename Allocator, typename G>
+void BasicParserContext<Allocator, G>::appendRawString(String & s,
+	std::string_view group)
+{
+	if constexpr (isSpanMode) {
+		// Span is extended to the end of the group, which follows it in the
+		// report; delimiters are joined lazily
+		if (group.empty()) return;
+		if (s.empty()) { s = rawString(group); return; }
+		s.length = static_cast<uint32_t>(group.data() + group.length() -
+			(report.data() + s.offset));
+	} else {
+		s += groupDelimiterChar;
+		s += group;
+	}
+}
+
+template <typename Allocator, typename G>
+std::string_view BasicParserContext<Allocator, G>::groupString(const String & s) {
+	if constexpr (isSpanMode) {
+		joinedGroups.clear();
+		ReportSpan::joinGroups(s.view(report), joinedGroups);
+		return joinedGroups;
+	} else {
+		return s;
+	}
+}
+
+template <typename Allocator, typename G>
+std::string_view BasicParserContext<Allocator, G>::sourceString(const String & s) {
+	if constexpr (isSpanMode) {
+		return s.view(report);
+	} else {
+		return s;
+	}
+}
+
+template <typename Allocator, typename G>
+void BasicParserContext<Allocator, G>::recycle(String && s) {
+	if constexpr (!isSpanMode) rawStringPool.push_back(std::move(s));
+}
+
+std::string ReportSpan::toString(std::string_view report) const {
+	std::string result;
+	joinGroups(view(report), result);
+	return result;
+}
+
+void ReportSpan::joinGroups(std::string_view text, std::string & output) {
+	Parser::ReportInput in(text);
+	std::string_view group;
+	in >> group;
+	bool first = true;
+	while (!group.empty()) {
+		if (!first) output += groupDelimiterChar;
+		output += group;
+		first = false;
+		in >> group;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ParseResult Parser::parse(std::string_view report, size_t groupLimit) {
+	ParserContext context;
+	parse(report, context, groupLimit);
+	return std::move(context.parseResult);
+}
+
+ParseResult Parser::parse(std::string_view report,
+	const ParseOptions & options,
+	size_t groupLimit)
+{
+	ParserContext context;
+	parse(report, context, options, groupLimit);
+	return std::move(context.parseResult);
+}
+
+pmr::ParseResult Parser::parse(std::string_view report,
+	std::pmr::polymorphic_allocator<char> allocator,
+	size_t groupLimit)
+{
+	pmr::ParserContext context(allocator);
+	parse(report, context, groupLimit);
+	return std::move(context.parseResult);
+}
+
+template <typename Allocator, typename G>
+const BasicParseResult<Allocator, G> & Parser::parse(std::string_view report,
+	BasicParserContext<Allocator, G> & context,
+	size_t groupLimit)
+{
+	return parse(report, context, ParseOptions(), groupLimit);
+}
+
+// Parsing of a report suspended after each group, so that the groups which
+// are final may be passed to the caller before the rest of the report is
+// parsed
+template <typename Allocator, typename G>
+class Parser::ParseState {
+public:
+	inline ParseState(std::string_view report,
+		BasicParserContext<Allocator, G> & context,
+		const ParseOptions & options,
+		size_t groupLimit);
+	// Parses the next group of the report; false if there are no more groups
+	inline bool parseGroup();
+	// Completes the parse result after the last group
+	inline void finish();
+	// Number of groups at the beginning of the parse result which cannot
+	// change any more: only the last group may be appended to or invalidated,
+	// and if it is invalidated and reparsed as a fallback group, it may be
+	// merged with the group before it
+	inline size_t finalGroupCount() const;
+	// Parses remarks of a report instead of a report; must be called before
+	// the first group is parsed
+	inline void startAtRemarks(const ReportMetadata & metadata);
+	// Parses groups until the first group of the parse result is final and
+	// finishes the result after the last group; false if no groups are left
+	inline bool parseFirstFinalGroup();
+	// Removes the first group of the parse result once it was passed on
+	inline void removeFirstGroup();
+	const BasicGroupInfo<Allocator, G> & firstGroup() const {
+		return context.parseResult.groups.front();
+	}
+	// Metadata of the groups parsed so far, complete once finished
+	const ReportMetadata & getReportMetadata() const {
+		return (finished ? context.parseResult.reportMetadata : reportMetadata);
+	}
 
-	bool reportEnd = false;
+private:
+	ReportInput in;
+	BasicParserContext<Allocator, G> & context;
+	const GroupTypeMask decodedTypes;
+	const bool skipRemarks;
+	const size_t maxSteps;
+	const size_t groupLimit;
 	Status status;
 	ReportMetadata reportMetadata;
-	ParseResult result;
 	size_t groupCount = 0;
+	bool finished = false;
+};
 
-	//Iterate through report groups separated by delimiters
-	std::string groupStr;
-	in >> groupStr;
-	while (!groupStr.empty() && !reportEnd && !status.isError()) {
+template <typename Allocator, typename G>
+Parser::ParseState<Allocator, G>::ParseState(std::string_view report,
+	BasicParserContext<Allocator, G> & context,
+	const ParseOptions & options,
+	size_t groupLimit) :
+		in(report),
+		context(context),
+		decodedTypes(options.decodedTypes | syntaxGroupTypes),
+		skipRemarks(options.skipRemarks),
+		maxSteps(options.maxSteps),
+		groupLimit(groupLimit)
+{
+	context.clear();
+	context.report = report;
+	if (options.maxReportLength && report.length() > options.maxReportLength) {
+		status.setError(ReportError::PARSE_LIMIT_EXCEEDED);
+	}
+	// Spans cannot address larger reports
+	if (BasicParserContext<Allocator, G>::isSpanMode &&
+		report.length() > std::numeric_limits<uint32_t>::max())
+	{
+		status.setError(ReportError::REPORT_TOO_LARGE);
+	}
+}
 
-		Group group;
-		ReportPart reportPart = status.getReportPart();
-		if (!appendToLastResultGroup(result, groupStr, reportPart, reportMetadata)) {
-			// Current group was not appended to last group
-			do {
-				// Group may be parsed multiple times because at this point
-				// parser may not know yet if the report is METAR or TAF
-				// and reportPart may change based on report type.
-				reportPart = status.getReportPart();
-				group = GroupParser::parse(groupStr, reportPart, reportMetadata);
-				status.transition(getSyntaxGroup(group));
-				groupCount++;
-				if (groupCount >= groupLimit) status.setError(ReportError::REPORT_TOO_LARGE);
-			} while(status.isReparseRequired()  && !status.isError());
-			updateMetadata(group, reportMetadata);
-			addGroupToResult(result, std::move(group), reportPart, std::move(groupStr));
-		} else {
-			// Raw string was appended to the group, just increase group count
+template <typename Allocator, typename G>
+bool Parser::ParseState<Allocator, G>::parseGroup() {
+	if (status.isError()) return false;
+	std::string_view groupStr;
+	in >> groupStr;
+	if (groupStr.empty()) return false;
+
+	G group;
+	ReportPart reportPart = status.getReportPart();
+	if (skipRemarks && reportPart == ReportPart::RMK) {
+		// Remark groups are merged into one fallback group; state of the
+		// syntax checker does not change in remarks
+		addGroupToResult(context, G(FallbackGroup()), reportPart, groupStr);
+		groupCount++;
+		if (groupCount >= groupLimit) status.setError(ReportError::REPORT_TOO_LARGE);
+		return true;
+	}
+	if (!appendToLastResultGroup(context,
+		groupStr,
+		reportPart,
+		reportMetadata,
+		decodedTypes))
+	{
+		// Current group was not appended to last group
+		do {
+			// Group may be parsed multiple times because at this point
+			// parser may not know yet if the report is METAR or TAF
+			// and reportPart may change based on report type.
+			reportPart = status.getReportPart();
+			group = BasicGroupParser<G>::parse(groupStr,
+				reportPart,
+				reportMetadata,
+				decodedTypes);
+			context.steps++;
+			status.transition(getSyntaxGroup(group));
 			groupCount++;
 			if (groupCount >= groupLimit) status.setError(ReportError::REPORT_TOO_LARGE);
-		}
-
-		in >> groupStr;
+			if (status.isReparseRequired()) context.counters.reportTypeReparses++;
+		} while(status.isReparseRequired()  && !status.isError());
+		// Alternatives tried before the one which recognised the group
+		// need not be tried again if the next group invalidates it;
+		// report time used by some alternatives is not changed by any
+		// group which may be invalidated
+		context.lastDecoded.group = groupStr;
+		context.lastDecoded.reportPart = reportPart;
+		context.lastDecoded.rejectedTypes = BasicGroupParser<G>::typesBefore(group);
+		updateMetadata(group, reportMetadata);
+		addGroupToResult(context, std::move(group), reportPart, groupStr);
+	} else {
+		// Raw string was appended to the group, just increase group count
+		groupCount++;
+		if (groupCount >= groupLimit) status.setError(ReportError::REPORT_TOO_LARGE);
 	}
+	if (maxSteps && context.steps > maxSteps && !status.isError())
+		status.setError(ReportError::PARSE_LIMIT_EXCEEDED);
+	return true;
+}
+
+template <typename Allocator, typename G>
+void Parser::ParseState<Allocator, G>::finish() {
+	auto & result = context.parseResult;
 	if (!result.groups.empty()) {
 		// if last group is incomplete, invalidate it by adding an empty string
-		appendToLastResultGroup(result, "", status.getReportPart(), reportMetadata);
+		appendToLastResultGroup(context,
+			"",
+			status.getReportPart(),
+			reportMetadata,
+			decodedTypes);
 		// but do not save this empty string if the group just rejects it
-		if (result.groups.back().rawString.empty()) result.groups.pop_back();
+		if (result.groups.back().rawString.empty()) {
+			context.recycle(std::move(result.groups.back().rawString));
+			result.groups.pop_back();
+		}
 	}
 	status.finalTransition();
 	reportMetadata.type = status.getReportType();
-	reportMetadata.error = status.getError();
+	// Error in metadata passed to startAtRemarks() is kept
+	if (status.isError()) reportMetadata.error = status.getError();
 	result.reportMetadata = std::move(reportMetadata);
+	finished = true;
+}
+
+template <typename Allocator, typename G>
+size_t Parser::ParseState<Allocator, G>::finalGroupCount() const {
+	const auto & groups = context.parseResult.groups;
+	if (groups.size() < 2) return 0;
+	if (std::holds_alternative<FallbackGroup>(groups[groups.size() - 2].group)) {
+		return groups.size() - 2;
+	}
+	return groups.size() - 1;
+}
+
+template <typename Allocator, typename G>
+void Parser::ParseState<Allocator, G>::startAtRemarks(const ReportMetadata & metadata) {
+	if (status.isError()) return;
+	reportMetadata = metadata;
+	const auto state = (metadata.type == ReportType::TAF) ?
+		Status::State::REMARK_TAF : Status::State::REMARK_METAR;
+	status = Status(state, metadata.type);
+}
+
+template <typename Allocator, typename G>
+bool Parser::ParseState<Allocator, G>::parseFirstFinalGroup() {
+	while (!finished && !finalGroupCount()) {
+		if (!parseGroup()) finish();
+	}
+	return !context.parseResult.groups.empty();
+}
+
+template <typename Allocator, typename G>
+void Parser::ParseState<Allocator, G>::removeFirstGroup() {
+	auto & groups = context.parseResult.groups;
+	context.recycle(std::move(groups.front().rawString));
+	groups.erase(groups.begin());
+}
+
+template <typename Allocator, typename G>
+const BasicParseResult<Allocator, G> & Parser::parse(std::string_view report,
+	BasicParserContext<Allocator, G> & context,
+	const ParseOptions & options,
+	size_t groupLimit)
+{
+	ParseState<Allocator, G> state(report, context, options, groupLimit);
+	while (state.parseGroup()) {}
+	state.finish();
+	return context.parseResult;
+}
+
+template <typename Callback, typename>
+ReportMetadata Parser::parse(std::string_view report,
+	Callback && callback,
+	const ParseOptions & options,
+	size_t groupLimit)
+{
+	ParserContext context;
+	return parse(report, context, callback, options, groupLimit);
+}
+
+template <typename Derived>
+ReportMetadata Parser::parse(std::string_view report,
+	StaticVisitor<Derived, void> & visitor,
+	const ParseOptions & options,
+	size_t groupLimit)
+{
+	ParserContext context;
+	return parse(report, context, visitor, options, groupLimit);
+}
+
+template <typename Allocator, typename G, typename Derived>
+const ReportMetadata & Parser::parse(std::string_view report,
+	BasicParserContext<Allocator, G> & context,
+	StaticVisitor<Derived, void> & visitor,
+	const ParseOptions & options,
+	size_t groupLimit)
+{
+	const auto visitGroup = [&visitor, report](const BasicGroupInfo<Allocator, G> & groupInfo) {
+		if constexpr (BasicParserContext<Allocator, G>::isSpanMode) {
+			visitor.visit(groupInfo, report);
+		} else {
+			visitor.visit(groupInfo);
+		}
+	};
+	return parse(report, context, visitGroup, options, groupLimit);
+}
+
+template <typename Allocator, typename G, typename Callback, typename>
+const ReportMetadata & Parser::parse(std::string_view report,
+	BasicParserContext<Allocator, G> & context,
+	Callback && callback,
+	const ParseOptions & options,
+	size_t groupLimit)
+{
+	ParseState<Allocator, G> state(report, context, options, groupLimit);
+	while (state.parseGroup()) {
+		passGroups(context, state.finalGroupCount(), callback);
+	}
+	state.finish();
+	passGroups(context, context.parseResult.groups.size(), callback);
+	return context.parseResult.reportMetadata;
+}
+
+template <typename Allocator, typename G, typename Callback>
+void Parser::passGroups(BasicParserContext<Allocator, G> & context,
+	size_t count,
+	Callback & callback)
+{
+	if (!count) return;
+	auto & groups = context.parseResult.groups;
+	for (size_t i = 0; i < count; i++) {
+		const auto & groupInfo = groups[i];
+		callback(groupInfo);
+		context.recycle(std::move(groups[i].rawString));
+	}
+	// At most two groups are left after the passed ones
+	groups.erase(groups.begin(), groups.begin() + count);
+}
+
+template <typename Allocator, typename G>
+typename BasicGroupRange<Allocator, G>::Iterator BasicGroupRange<Allocator, G>::begin() {
+	if (!started) {
+		started = true;
+		hasGroup = state.parseFirstFinalGroup();
+	}
+	return (hasGroup ? Iterator(this) : end());
+}
+
+template <typename Allocator, typename G>
+bool BasicGroupRange<Allocator, G>::next() {
+	state.removeFirstGroup();
+	hasGroup = state.parseFirstFinalGroup();
+	return hasGroup;
+}
+
+ParseResult Parser::parseRemarks(std::string_view remarks,
+	const ReportMetadata & reportMetadata,
+	const ParseOptions & options,
+	size_t groupLimit)
+{
+	ParserContext context;
+	parseRemarks(remarks, reportMetadata, context, options, groupLimit);
+	return std::move(context.parseResult);
+}
+
+template <typename Allocator, typename G>
+const BasicParseResult<Allocator, G> & Parser::parseRemarks(
+	std::string_view remarks,
+	const ReportMetadata & reportMetadata,
+	BasicParserContext<Allocator, G> & context,
+	const ParseOptions & options,
+	size_t groupLimit)
+{
+	auto remarkOptions = options;
+	remarkOptions.skipRemarks = false;
+	ParseState<Allocator, G> state(remarks, context, remarkOptions, groupLimit);
+	state.startAtRemarks(reportMetadata);
+	while (state.parseGroup()) {}
+	state.finish();
+	return context.parseResult;
+}
+
+ValidationResult Parser::validate(std::string_view report,
+	size_t groupLimit) noexcept
+{
+	using SyntaxGroupVariant = std::variant<KeywordGroup,
+		LocationGroup,
+		ReportTimeGroup,
+		TrendGroup,
+		FallbackGroup>;
+	ReportInput in(report);
+	Status status;
+	// Not updated: groups which determine syntax do not depend on metadata
+	const ReportMetadata reportMetadata;
+	ValidationResult result;
+
+	// Groups which determine syntax are never invalidated and only trend
+	// groups may be appended to, so no group list or raw strings are kept
+	SyntaxGroupVariant lastGroup = FallbackGroup();
+	size_t groupCount = 0;
+	std::string_view groupStr;
+	in >> groupStr;
+	while (!groupStr.empty() && !status.isError()) {
+		auto lastTrend = std::get_if<TrendGroup>(&lastGroup);
+		if (lastTrend &&
+			lastTrend->append(groupStr, status.getReportPart(), reportMetadata) ==
+				AppendResult::APPENDED)
+		{
+			groupCount++;
+			if (groupCount >= groupLimit) status.setError(ReportError::REPORT_TOO_LARGE);
+		} else {
+			do {
+				lastGroup = BasicGroupParser<SyntaxGroupVariant>::parse(groupStr,
+					status.getReportPart(),
+					reportMetadata);
+				status.transition(getSyntaxGroup(lastGroup));
+				groupCount++;
+				if (groupCount >= groupLimit) status.setError(ReportError::REPORT_TOO_LARGE);
+			} while(status.isReparseRequired() && !status.isError());
+		}
+		if (status.isError()) result.errorOffset = groupStr.data() - report.data();
+		in >> groupStr;
+	}
+	if (!status.isError()) {
+		status.finalTransition();
+		if (status.isError()) result.errorOffset = report.length();
+	}
+	result.type = status.getReportType();
+	result.error = status.getError();
 	return result;
 }
 
-bool Parser::appendToLastResultGroup(ParseResult & result,
-	const std::string & groupStr,
+ReportMetadata Parser::parseMetadata(std::string_view report) {
+	ReportInput in(report);
+	Status status;
+	ReportMetadata reportMetadata;
+
+	// Header groups never append the next group, so each group is parsed
+	// on its own and no parse result is kept
+	std::string_view groupStr;
+	in >> groupStr;
+	while (!groupStr.empty() &&
+		!status.isError() &&
+		!status.isReportBodyStarted())
+	{
+		Group group;
+		do {
+			group = GroupParser::parse(groupStr,
+				status.getReportPart(),
+				reportMetadata);
+			status.transition(getSyntaxGroup(group));
+		} while(status.isReparseRequired() && !status.isError());
+		updateMetadata(group, reportMetadata);
+		in >> groupStr;
+	}
+	status.finalTransition();
+	reportMetadata.type = status.getReportType();
+	reportMetadata.error = status.getError();
+	return reportMetadata;
+}
+
+template <typename Allocator, typename G>
+bool Parser::appendToLastResultGroup(BasicParserContext<Allocator, G> & context,
+	std::string_view groupStr,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata,
+	GroupTypeMask decodedTypes,
 	bool allowReparse)
 {
+	auto & result = context.parseResult;
 	// Unable to append if this is the first group
 	if (result.groups.empty()) return false;
 
@@ -6819,9 +8551,10 @@ bool Parser::appendToLastResultGroup(ParseResult & result,
 	// used only if all parse attempts by other groups failed
 	if (std::holds_alternative<FallbackGroup>(result.groups.back().group)) return false;
 
-	GroupInfo & lastGroupInfo = result.groups.back();
-	Group & lastGroup = lastGroupInfo.group;
+	auto & lastGroupInfo = result.groups.back();
+	auto & lastGroup = lastGroupInfo.group;
 
+	context.steps++;
 	const auto appendResult = std::visit(
 		[&](auto && gr) -> AppendResult {
 			return gr.append(groupStr, reportPart, reportMetadata);
@@ -6829,8 +8562,7 @@ bool Parser::appendToLastResultGroup(ParseResult & result,
 
 	switch (appendResult) {
 		case AppendResult::APPENDED:
-		lastGroupInfo.rawString += groupDelimiterChar;
-		lastGroupInfo.rawString += groupStr;
+		context.appendRawString(lastGroupInfo.rawString, groupStr);
 		return true;
 
 		case AppendResult::NOT_APPENDED:
@@ -6838,74 +8570,223 @@ bool Parser::appendToLastResultGroup(ParseResult & result,
 
 		case AppendResult::GROUP_INVALIDATED:
 		{
-			std::string prevStr = std::move(result.groups.back().rawString);
+			// Raw string is taken out of the invalidated group which is left
+			// with an empty pooled string, so that no string storage is lost
+			auto prevStr = context.rawString(std::string_view());
+			std::swap(prevStr, result.groups.back().rawString);
 			const auto prevRp = result.groups.back().reportPart;
 			const auto & prevGroup = result.groups.back().group;
 			if (!allowReparse) {
-				addGroupToResult(result, FallbackGroup(), prevRp, std::move(prevStr));
+				// Last group is never a fallback group here, so the raw string
+				// is not merged and can be moved into the new group
+				result.groups.emplace_back(FallbackGroup(), prevRp, std::move(prevStr));
 				return false;
 			}
+			// Alternatives which rejected the same group string in the same
+			// report part are not tried again
+			auto & lastDecoded = context.lastDecoded;
+			const auto prevGroupStr = context.groupString(prevStr);
+			const bool isLastDecoded = (prevRp == lastDecoded.reportPart &&
+				prevGroupStr == lastDecoded.group);
+			const auto rejectedTypes =
+				isLastDecoded ? lastDecoded.rejectedTypes : GroupTypeMask();
+			context.steps++;
+			context.counters.invalidatedReparses++;
+			if (isLastDecoded) context.counters.cachedReparses++;
 			const auto reparsed =
-				GroupParser::reparse(prevStr, prevRp, reportMetadata, prevGroup);
+				BasicGroupParser<G>::reparse(prevGroupStr,
+					prevRp,
+					reportMetadata,
+					prevGroup,
+					decodedTypes,
+					rejectedTypes);
+			if (isLastDecoded) {
+				lastDecoded.rejectedTypes = rejectedTypes |
+					groupTypeOf(prevGroup) |
+					BasicGroupParser<G>::typesBefore(reparsed);
+			} else {
+				lastDecoded = typename BasicParserContext<Allocator, G>::DecodedGroup();
+			}
 			const bool reparsedIsOtherGroup =
 				!std::holds_alternative<FallbackGroup>(reparsed);
+			context.recycle(std::move(result.groups.back().rawString));
 			result.groups.pop_back();
-			addGroupToResult(result, std::move(reparsed), prevRp, std::move(prevStr));
+			addGroupToResult(context,
+				std::move(reparsed),
+				prevRp,
+				context.sourceString(prevStr));
+			context.recycle(std::move(prevStr));
 			if (!reparsedIsOtherGroup) return false;
-			return appendToLastResultGroup(result, groupStr, reportPart, reportMetadata, false);
+			return appendToLastResultGroup(context,
+				groupStr,
+				reportPart,
+				reportMetadata,
+				decodedTypes,
+				false);
 		}
 	}
 }
 
-void Parser::addGroupToResult(ParseResult & result,
-	Group group,
+template <typename Allocator, typename G>
+void Parser::addGroupToResult(BasicParserContext<Allocator, G> & context,
+	G group,
 	ReportPart reportPart,
-	std::string groupString)
+	std::string_view groupString)
 {
+	auto & result = context.parseResult;
 	if (!result.groups.empty() && std::holds_alternative<FallbackGroup>(group)) {
 		// Assumed that two fallback groups can always be appended
-		GroupInfo & lastGroupInfo = result.groups.back();
+		auto & lastGroupInfo = result.groups.back();
 		if (std::get_if<FallbackGroup>(&lastGroupInfo.group)) {
-			lastGroupInfo.rawString += groupDelimiterChar;
-			lastGroupInfo.rawString += groupString;
+			context.appendRawString(lastGroupInfo.rawString, groupString);
 			return;
 		}
 	}
-	GroupInfo groupInfo(std::move(group), reportPart, groupString);
-	result.groups.push_back(std::move(groupInfo));
+	result.groups.emplace_back(std::move(group),
+		reportPart,
+		context.rawString(groupString));
 }
 
 
-std::string Parser::ReportInput::getNextGroup() {
-	if (finished) return std::string();
+std::string_view Parser::ReportInput::getNextGroup() {
+	if (finished) return std::string_view();
 
 	// ASCII control codes and spaces are concidered delimiters
-	while (report[pos] <= ' ') {
-		if (pos >= report.length()) {
-			finished = true;
-			return std::string();
-		}
-		pos++;
+	pos = findNonDelimiter(pos);
+	if (pos >= report.length()) {
+		finished = true;
+		return std::string_view();
 	}
 
-	size_t groupLen = 0;
-	while (report[pos + groupLen] > ' ') {
-		// Detect end of report or report end char
-		if (pos >= report.length() || report[pos + groupLen] == reportEndChar) {
-			finished = true;
-			break;
-//			return report.substr(pos, groupLen);
-		}
-		// Treat '+' character as a delimiter to extract groups like BLU+ but
-		// ignore '+' character if it is in front of the group (e.g. +RA)
-		if (groupLen && report[pos+groupLen] == '+') { groupLen++; break; }
-		groupLen++;
+	// Treat '+' character as a delimiter to extract groups like BLU+ but
+	// ignore '+' character if it is in front of the group (e.g. +RA)
+	const auto groupEnd = findGroupEnd(report[pos] == '+' ? pos + 1 : pos);
+	size_t groupLen = groupEnd - pos;
+	if (groupEnd < report.length()) {
+		// Detect report end char
+		if (report[groupEnd] == reportEndChar) finished = true;
+		if (report[groupEnd] == '+') groupLen++;
 	}
 	const auto prevPos = pos;
 	pos = pos + groupLen;
 	return report.substr(prevPos, groupLen);
 }
 
+size_t Parser::ReportInput::findNonDelimiter(size_t from) {
+	if (!scanBlock) {
+		while (from < report.length() && report[from] <= ' ') from++;
+		return from;
+	}
+	while (from < report.length()) {
+		const auto start = from - from % blockSize;
+		loadBlock(start);
+		const auto mask = ~blockMasks.delimiters & (~uint64_t(0) << (from - start));
+		if (mask) {
+			const auto result = start + countTrailingZeros(mask);
+			return (result < report.length() ? result : report.length());
+		}
+		from = start + blockSize;
+	}
+	return report.length();
+}
+
+size_t Parser::ReportInput::findGroupEnd(size_t from) {
+	if (!scanBlock) {
+		while (from < report.length() && report[from] > ' ' &&
+			report[from] != reportEndChar && report[from] != '+') from++;
+		return from;
+	}
+	while (from < report.length()) {
+		const auto start = from - from % blockSize;
+		loadBlock(start);
+		const auto mask = blockMasks.groupEnds & (~uint64_t(0) << (from - start));
+		if (mask) {
+			const auto result = start + countTrailingZeros(mask);
+			return (result < report.length() ? result : report.length());
+		}
+		from = start + blockSize;
+	}
+	return report.length();
+}
+
+void Parser::ReportInput::loadBlock(size_t start) {
+	if (start == blockStart) return;
+	blockStart = start;
+	if (report.length() - start >= blockSize) {
+		blockMasks = scanBlock(report.data() + start);
+		return;
+	}
+	// Last block is padded with delimiters so that SIMD does not read past
+	// the end of the report
+	char block[blockSize];
+	std::memset(block, groupDelimiterChar, blockSize);
+	std::memcpy(block, report.data() + start, report.length() - start);
+	blockMasks = scanBlock(block);
+}
+
+#ifdef METAF_SIMD_SSE2
+Parser::ReportInput::BlockMasks Parser::ReportInput::scanBlockSse2(
+	const char * block)
+{
+	// Signed comparison c < '!' matches c <= ' ' for signed char, i.e. chars
+	// 0x80..0xFF are delimiters, same as in char-by-char scanning
+	const auto firstNonDelimiter = _mm_set1_epi8('!');
+	const auto reportEnd = _mm_set1_epi8(reportEndChar);
+	const auto plus = _mm_set1_epi8('+');
+	BlockMasks result;
+	for (auto i = 0u; i < blockSize; i += 16) {
+		const auto chars =
+			_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+		const auto delimiters = _mm_cmplt_epi8(chars, firstNonDelimiter);
+		const auto groupEnds = _mm_or_si128(delimiters,
+			_mm_or_si128(_mm_cmpeq_epi8(chars, reportEnd),
+				_mm_cmpeq_epi8(chars, plus)));
+		result.delimiters |= uint64_t(uint16_t(_mm_movemask_epi8(delimiters))) << i;
+		result.groupEnds |= uint64_t(uint16_t(_mm_movemask_epi8(groupEnds))) << i;
+	}
+	return result;
+}
+#endif
+
+#ifdef METAF_SIMD_AVX2
+__attribute__((target("avx2")))
+Parser::ReportInput::BlockMasks Parser::ReportInput::scanBlockAvx2(
+	const char * block)
+{
+	// See scanBlockSse2
+	const auto firstNonDelimiter = _mm256_set1_epi8('!');
+	const auto reportEnd = _mm256_set1_epi8(reportEndChar);
+	const auto plus = _mm256_set1_epi8('+');
+	BlockMasks result;
+	for (auto i = 0u; i < blockSize; i += 32) {
+		const auto chars =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i));
+		const auto delimiters = _mm256_cmpgt_epi8(firstNonDelimiter, chars);
+		const auto groupEnds = _mm256_or_si256(delimiters,
+			_mm256_or_si256(_mm256_cmpeq_epi8(chars, reportEnd),
+				_mm256_cmpeq_epi8(chars, plus)));
+		result.delimiters |= uint64_t(uint32_t(_mm256_movemask_epi8(delimiters))) << i;
+		result.groupEnds |= uint64_t(uint32_t(_mm256_movemask_epi8(groupEnds))) << i;
+	}
+	return result;
+}
+#endif
+
+Parser::ReportInput::ScanFunction Parser::ReportInput::selectScanFunction() {
+	// Null function means that report is scanned char by char
+	// SIMD versions assume that char is signed, as it is on x86-64 by default
+	if constexpr (!std::is_signed<char>::value) return nullptr;
+#ifdef METAF_SIMD_AVX2
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	if (avx2) return scanBlockAvx2;
+#endif
+#ifdef METAF_SIMD_SSE2
+	return scanBlockSse2;
+#else
+	return nullptr;
+#endif
+}
+
 
 ReportPart Parser::Status::getReportPart() {
 	switch (state) {
@@ -6936,239 +8817,215 @@ ReportPart Parser::Status::getReportPart() {
 	}
 }
 
-void Parser::Status::transition(SyntaxGroup group) {
+bool Parser::Status::isReportBodyStarted() {
 	switch (state) {
-		case State::REPORT_TYPE_OR_LOCATION:
-		transitionFromReportTypeOrLocation(group);
-		break;
+		case State::REPORT_BODY_METAR:
+		case State::REPORT_BODY_TAF:
+		case State::REMARK_METAR:
+		case State::REMARK_TAF:
+		return true;
 
-		case State::CORRECTION:
-		transitionFromCorrecton(group);
-		break;
+		default:
+		return false;
+	}
+}
 
-		case State::LOCATION:
-		if (group == SyntaxGroup::LOCATION) {setState(State::REPORT_TIME); break;}
-		setError(ReportError::EXPECTED_LOCATION);
-		break;
+constexpr Parser::Status::Transition Parser::Status::transitionFor(State state,
+	ReportType reportType,
+	SyntaxGroup group)
+{
+	// Report type is only changed by transitions which determine it
+	const auto to = [reportType](State s) {
+		return Transition {s, reportType, ReportError::NONE, 0};
+	};
+	const auto error = [reportType](ReportError e) {
+		return Transition {State::ERROR, reportType, e, 0};
+	};
+	switch (state) {
+		case State::REPORT_TYPE_OR_LOCATION:
+		switch(group) {
+			case SyntaxGroup::METAR:
+			case SyntaxGroup::SPECI:
+			return Transition {State::CORRECTION, ReportType::METAR, ReportError::NONE, 0};
 
-		case State::REPORT_TIME:
-		transitionFromReportTime(group);
-		break;
+			case SyntaxGroup::TAF:
+			return Transition {State::CORRECTION, ReportType::TAF, ReportError::NONE, 0};
 
-		case State::TIME_SPAN:
-		transitionFromTimeSpan(group);
-		break;
+			case SyntaxGroup::LOCATION:
+			return to(State::REPORT_TIME);
 
-		case State::REPORT_BODY_BEGIN_METAR:
-		case State::REPORT_BODY_BEGIN_METAR_REPEAT_PARSE:
-		transitionFromReportBodyBeginMetar(group);
-		break;
+			default:
+			return error(ReportError::EXPECTED_REPORT_TYPE_OR_LOCATION);
+		}
 
-		case State::REPORT_BODY_METAR:
-		transitionFromReportBodyMetar(group);
-		break;
+		case State::CORRECTION:
+		switch (group) {
+			case SyntaxGroup::AMD:
+			if (reportType != ReportType::TAF)
+				return error(ReportError::AMD_ALLOWED_IN_TAF_ONLY);
+			return to(State::LOCATION);
 
-		case State::REPORT_BODY_BEGIN_TAF:
-		transitionFromReportBodyBeginTaf(group);
-		break;
+			case SyntaxGroup::COR:
+			return to(State::LOCATION);
 
-		case State::REPORT_BODY_TAF:
-		transitionFromReportBodyTaf(group);
-		break;
+			case SyntaxGroup::LOCATION:
+			return to(State::REPORT_TIME);
 
-		case State::REMARK_TAF:
-		if (group == SyntaxGroup::MAINTENANCE_INDICATOR) {
-			setError(ReportError::MAINTENANCE_INDICATOR_ALLOWED_IN_METAR_ONLY);
+			default:
+			return error(ReportError::EXPECTED_LOCATION);
 		}
-		break;
 
-		case State::NIL:
-		setError(ReportError::UNEXPECTED_GROUP_AFTER_NIL);
-		break;
-
-		case State::CNL:
-		setError(ReportError::UNEXPECTED_GROUP_AFTER_CNL);
-		break;
+		case State::LOCATION:
+		if (group == SyntaxGroup::LOCATION) return to(State::REPORT_TIME);
+		return error(ReportError::EXPECTED_LOCATION);
 
-		case State::REMARK_METAR:
-		case State::ERROR:
-		break;
-	}
-}
+		case State::REPORT_TIME:
+		switch (group) {
+			case SyntaxGroup::REPORT_TIME:
+			if (reportType == ReportType::METAR)
+				return to(State::REPORT_BODY_BEGIN_METAR);
+			return to(State::TIME_SPAN);
 
-void Parser::Status::transitionFromReportTypeOrLocation(SyntaxGroup group) {
-	switch(group) {
-		case SyntaxGroup::METAR:
-		case SyntaxGroup::SPECI:
-		setReportType(ReportType::METAR);
-		setState(State::CORRECTION);
-		break;
+			case SyntaxGroup::TIME_SPAN:
+			if (reportType == ReportType::TAF)
+				return to(State::REPORT_BODY_BEGIN_TAF);
+			return error(ReportError::EXPECTED_REPORT_TIME);
 
-		case SyntaxGroup::TAF:
-		setReportType(ReportType::TAF);
-		setState(State::CORRECTION);
-		break;
+			case SyntaxGroup::NIL:
+			return to(State::NIL);
 
-		case SyntaxGroup::LOCATION:
-		setState(State::REPORT_TIME);
-		break;
+			default:
+			return error(ReportError::EXPECTED_REPORT_TIME);
+		}
 
-		default:
-		setError(ReportError::EXPECTED_REPORT_TYPE_OR_LOCATION);
-		break;
-	}
-}
+		case State::TIME_SPAN:
+		switch(group) {
+			case SyntaxGroup::TIME_SPAN:
+			return Transition {State::REPORT_BODY_BEGIN_TAF,
+				ReportType::TAF,
+				ReportError::NONE,
+				0};
 
-void Parser::Status::transitionFromCorrecton(SyntaxGroup group) {
-	switch (group) {
-		case SyntaxGroup::AMD:
-		setState(State::LOCATION);
-		if (getReportType() != ReportType::TAF)
-			setError(ReportError::AMD_ALLOWED_IN_TAF_ONLY);
-		break;
+			case SyntaxGroup::NIL:
+			return to(State::NIL);
 
-		case SyntaxGroup::COR:
-		setState(State::LOCATION);
-		break;
+			default:
+			if (reportType == ReportType::UNKNOWN) {
+				return Transition {State::REPORT_BODY_BEGIN_METAR_REPEAT_PARSE,
+					ReportType::METAR,
+					ReportError::NONE,
+					0};
+			}
+			return error(ReportError::EXPECTED_TIME_SPAN);
+		}
 
-		case SyntaxGroup::LOCATION:
-		setState(State::REPORT_TIME);
-		break;
+		case State::REPORT_BODY_BEGIN_METAR:
+		case State::REPORT_BODY_BEGIN_METAR_REPEAT_PARSE:
+		switch(group) {
+			case SyntaxGroup::NIL:
+			return to(State::NIL);
 
-		default:
-		setError(ReportError::EXPECTED_LOCATION);
-		break;
-	}
-}
+			case SyntaxGroup::CNL:
+			return error(ReportError::CNL_ALLOWED_IN_TAF_ONLY);
 
-void Parser::Status::transitionFromReportTime(SyntaxGroup group) {
-	switch (group) {
-		case SyntaxGroup::REPORT_TIME:
-		if (reportType == ReportType::METAR) {
-			setState(State::REPORT_BODY_BEGIN_METAR);
-			break;
-		}
-		setState(State::TIME_SPAN);
-		break;
+			case SyntaxGroup::RMK:
+			return to(State::REMARK_METAR);
 
-		case SyntaxGroup::TIME_SPAN:
-		if (getReportType() == ReportType::TAF) {
-			setState(State::REPORT_BODY_BEGIN_TAF);
-			break;
+			default:
+			return to(State::REPORT_BODY_METAR);
 		}
-		setError(ReportError::EXPECTED_REPORT_TIME);
-		break;
-
-		case SyntaxGroup::NIL:
-		setState(State::NIL);
-		break;
-
-		default:
-		setError(ReportError::EXPECTED_REPORT_TIME);
-		break;
-	}
-}
 
-void Parser::Status::transitionFromTimeSpan(SyntaxGroup group) {
-	switch(group) {
-		case SyntaxGroup::TIME_SPAN:
-		setReportType(ReportType::TAF);
-		setState(State::REPORT_BODY_BEGIN_TAF);
-		break;
+		case State::REPORT_BODY_METAR:
+		switch(group) {
+			case SyntaxGroup::RMK:
+			return to(State::REMARK_METAR);
 
-		case SyntaxGroup::NIL:
-		setState(State::NIL);
-		break;
+			case SyntaxGroup::NIL:
+			case SyntaxGroup::CNL:
+			return error(ReportError::UNEXPECTED_NIL_OR_CNL_IN_REPORT_BODY);
 
-		default:
-		if (getReportType() == ReportType::UNKNOWN) {
-			setReportType(ReportType::METAR);
-			setState(State::REPORT_BODY_BEGIN_METAR_REPEAT_PARSE);
-			break;
+			default:
+			return to(state);
 		}
-		setError(ReportError::EXPECTED_TIME_SPAN);
-		break;
-	}
-}
 
-void Parser::Status::transitionFromReportBodyBeginMetar(SyntaxGroup group) {
-	switch(group) {
-		case SyntaxGroup::NIL:
-		setState(State::NIL);
-		break;
+		case State::REPORT_BODY_BEGIN_TAF:
+		switch(group) {
+			case SyntaxGroup::NIL:
+			return to(State::NIL);
 
-		case SyntaxGroup::CNL:
-		setError(ReportError::CNL_ALLOWED_IN_TAF_ONLY);
-		break;
+			case SyntaxGroup::CNL:
+			return to(State::CNL);
 
-		case SyntaxGroup::RMK:
-		setState(State::REMARK_METAR);
-		break;
+			case SyntaxGroup::RMK:
+			return to(State::REMARK_TAF);
 
-		default:
-		setState(State::REPORT_BODY_METAR);
-		break;
-	}
-}
+			case SyntaxGroup::MAINTENANCE_INDICATOR:
+			return error(ReportError::MAINTENANCE_INDICATOR_ALLOWED_IN_METAR_ONLY);
 
-void Parser::Status::transitionFromReportBodyMetar(SyntaxGroup group) {
-	switch(group) {
-		case SyntaxGroup::RMK:
-		setState(State::REMARK_METAR);
-		break;
+			default:
+			return to(State::REPORT_BODY_TAF);
+		}
 
-		case SyntaxGroup::NIL:
-		case SyntaxGroup::CNL:
-		setError(ReportError::UNEXPECTED_NIL_OR_CNL_IN_REPORT_BODY);
-		break;
+		case State::REPORT_BODY_TAF:
+		switch(group) {
+			case SyntaxGroup::RMK:
+			return to(State::REMARK_TAF);
 
-		default:
-		break;
-	}
-}
+			case SyntaxGroup::NIL:
+			case SyntaxGroup::CNL:
+			return error(ReportError::UNEXPECTED_NIL_OR_CNL_IN_REPORT_BODY);
 
-void Parser::Status::transitionFromReportBodyBeginTaf(SyntaxGroup group) {
-	switch(group) {
-		case SyntaxGroup::NIL:
-		setState(State::NIL);
-		break;
+			case SyntaxGroup::MAINTENANCE_INDICATOR:
+			return error(ReportError::MAINTENANCE_INDICATOR_ALLOWED_IN_METAR_ONLY);
 
-		case SyntaxGroup::CNL:
-		setState(State::CNL);
-		break;
+			default:
+			return to(state);
+		}
 
-		case SyntaxGroup::RMK:
-		setState(State::REMARK_TAF);
-		break;
+		case State::REMARK_TAF:
+		if (group == SyntaxGroup::MAINTENANCE_INDICATOR)
+			return error(ReportError::MAINTENANCE_INDICATOR_ALLOWED_IN_METAR_ONLY);
+		return to(state);
 
-		case SyntaxGroup::MAINTENANCE_INDICATOR:
-		setError(ReportError::MAINTENANCE_INDICATOR_ALLOWED_IN_METAR_ONLY);
-		break;
+		case State::NIL:
+		return error(ReportError::UNEXPECTED_GROUP_AFTER_NIL);
 
-		default:
-		setState(State::REPORT_BODY_TAF);
-		break;
+		case State::CNL:
+		return error(ReportError::UNEXPECTED_GROUP_AFTER_CNL);
+
+		case State::REMARK_METAR:
+		case State::ERROR:
+		return to(state);
 	}
+	return to(state);
 }
 
-void Parser::Status::transitionFromReportBodyTaf(SyntaxGroup group) {
-	switch(group) {
-		case SyntaxGroup::RMK:
-		setState(State::REMARK_TAF);
-		break;
-
-		case SyntaxGroup::NIL:
-		case SyntaxGroup::CNL:
-		setError(ReportError::UNEXPECTED_NIL_OR_CNL_IN_REPORT_BODY);
-		break;
-
-		case SyntaxGroup::MAINTENANCE_INDICATOR:
-		setError(ReportError::MAINTENANCE_INDICATOR_ALLOWED_IN_METAR_ONLY);
-		break;
+const Parser::Status::TransitionTable & Parser::Status::transitionTable() {
+	static constexpr TransitionTable table = [] {
+		TransitionTable t {};
+		for (auto s = 0u; s < stateCount; s++)
+			for (auto rt = 0u; rt < reportTypeCount; rt++)
+				for (auto g = 0u; g < syntaxGroupCount; g++) {
+					const auto state = static_cast<State>(s);
+					const auto reportType = static_cast<ReportType>(rt);
+					const auto group = static_cast<SyntaxGroup>(g);
+					auto & entry = t[tableIndex(state, reportType, group)];
+					entry = transitionFor(state, reportType, group);
+					entry.row = rowIndex(entry.state, entry.reportType);
+				}
+		return t;
+	}();
+	return table;
+}
 
-		default:
-		break;
-	}
+void Parser::Status::transition(SyntaxGroup group) {
+	const auto & t =
+		transitionTable()[static_cast<size_t>(group) * rowCount + row];
+	state = t.state;
+	reportType = t.reportType;
+	row = t.row;
+	// Transitions from ERROR state keep the error detected earlier
+	if (t.reportError != ReportError::NONE) reportError = t.reportError;
 }
 
 void Parser::Status::finalTransition() {
@@ -7198,7 +9055,8 @@ void Parser::Status::finalTransition() {
 	}
 }
 
-void Parser::updateMetadata(const Group & group, ReportMetadata & reportMetadata) {
+template <typename G>
+void Parser::updateMetadata(const G & group, ReportMetadata & reportMetadata) {
 	if (const auto keyword = std::get_if<KeywordGroup>(&group); keyword)
 		switch (keyword->type()) {
 			case KeywordGroup::Type::SPECI:
@@ -7256,7 +9114,7 @@ void Parser::updateMetadata(const Group & group, ReportMetadata & reportMetadata
 	}
 	if (const auto location = std::get_if<LocationGroup>(&group); location)
 		reportMetadata.icaoLocation = location->toString();
-	if (const auto misc = std::get_if<MiscGroup>(&group);
+	if (const auto misc = getGroupIf<MiscGroup>(group);
 		misc &&
 		misc->type() == MiscGroup::Type::CORRECTED_WEATHER_OBSERVATION &&
 		misc->data().has_value()) {
@@ -0,0 +1,549 @@
+/*
+* Copyright (C) 2018-2020 Nick Naumenko (https://gitlab.com/nnaumenko)
+* All rights reserved.
+* This software may be modified and distributed under the terms
+* of the MIT license. See the LICENSE file for details.
+*/
+#ifndef METAF_BULK_HPP
+#define METAF_BULK_HPP
+
+#include "metaf.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <cerrno>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <thread>
+
+#if __has_include(<unistd.h>)
+	#include <unistd.h>
+	#define METAF_POSIX_IO
+#endif
+
+#if __has_include(<sys/mman.h>)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#define METAF_POSIX_MMAP
+#endif
+
+namespace metaf {
+
+// Fixed-size thread pool running batches of indexed tasks; each worker has its
+// own task queue and steals from the back of other queues when its own queue
+// is empty, so that uneven chunks (e.g. long TAFs) do not leave threads idle
+class WorkStealingPool {
+public:
+	explicit inline WorkStealingPool(size_t threadCount = defaultThreadCount());
+	inline ~WorkStealingPool();
+	WorkStealingPool(const WorkStealingPool &) = delete;
+	WorkStealingPool & operator=(const WorkStealingPool &) = delete;
+
+	static size_t defaultThreadCount() {
+		const auto n = std::thread::hardware_concurrency();
+		return (n ? n : 1);
+	}
+	size_t threadCount() const { return workers.size(); }
+
+	// Calls task(i) for every i in range [0, taskCount) and returns when all
+	// calls are finished; the first exception thrown by a task is rethrown;
+	// concurrent calls are serialised
+	inline void run(size_t taskCount, const std::function<void(size_t)> & task);
+
+private:
+	struct TaskQueue {
+		std::mutex mutex;
+		std::deque<size_t> tasks;
+	};
+
+	inline void workerLoop(size_t workerIndex);
+	inline bool takeTask(size_t workerIndex, size_t & taskIndex);
+
+	std::vector<std::unique_ptr<TaskQueue>> queues;
+	std::vector<std::thread> workers;
+
+	std::mutex runMutex;
+	std::mutex mutex;
+	std::condition_variable taskAvailable;
+	std::condition_variable batchFinished;
+	const std::function<void(size_t)> * currentTask = nullptr;
+	size_t generation = 0;
+	size_t remainingTasks = 0;
+	size_t activeWorkers = 0;
+	bool stopping = false;
+	std::exception_ptr taskError;
+};
+
+// Parses large numbers of reports on a WorkStealingPool; reports are split
+// into chunks of consecutive reports and results are stored in input order
+class BulkParser {
+public:
+	static const inline size_t defaultChunkSize = 256;
+
+	explicit BulkParser(size_t threadCount = WorkStealingPool::defaultThreadCount(),
+		size_t chunkSize = defaultChunkSize) :
+		pool(threadCount), chunk(chunkSize ? chunkSize : 1) {}
+
+	size_t threadCount() const { return pool.threadCount(); }
+	size_t chunkSize() const { return chunk; }
+
+	// Reports is a random-access container of items convertible to
+	// std::string_view (e.g. std::vector<std::string>)
+	template <typename Reports>
+	inline std::vector<ParseResult> parse(const Reports & reports,
+		size_t groupLimit = 200);
+
+private:
+	WorkStealingPool pool;
+	size_t chunk;
+};
+
+// Reads reports one by one from a stream or file descriptor containing many
+// reports (e.g. WMO bulletins or NOAA cycle files) and parses each of them;
+// reports are separated by report end char '=' or by blank lines
+// Buffer grows to fit a report longer than the buffer up to the maximum report
+// size; a longer report is skipped (no part of it is returned as a report)
+// and counted by skippedReports(), so that memory use stays bounded by about
+// twice the maximum report size; a report may also be skipped if a line
+// break after it is followed by more whitespace than the maximum report
+// size, because the reader cannot tell yet whether the report continues on
+// the next line
+// When constructed from a string_view (e.g. MappedFile::data()) the input is
+// used in place without buffering and report texts remain valid as long as
+// the input does
+class BulletinReader {
+public:
+	static const inline size_t defaultBufferSize = 65536;
+	static const inline size_t defaultMaxReportSize = 1048576;
+
+	explicit BulletinReader(std::istream & input,
+		size_t bufferSize = defaultBufferSize,
+		size_t maxReportSize = defaultMaxReportSize) :
+		stream(&input), buffer(bufferSize ? bufferSize : 1),
+		data(buffer.data()), maxReport(maxReportSize) {}
+#ifdef METAF_POSIX_IO
+	explicit BulletinReader(int fileDescriptor,
+		size_t bufferSize = defaultBufferSize,
+		size_t maxReportSize = defaultMaxReportSize) :
+		fd(fileDescriptor), buffer(bufferSize ? bufferSize : 1),
+		data(buffer.data()), maxReport(maxReportSize) {}
+#endif
+	// Input is not buffered, so report size is not limited
+	explicit BulletinReader(std::string_view input) :
+		data(input.data()), end(input.size()), inputEnd(true) {}
+	// Data pointer refers to the buffer, so the reader is movable only
+	BulletinReader(const BulletinReader &) = delete;
+	BulletinReader & operator=(const BulletinReader &) = delete;
+	BulletinReader(BulletinReader &&) = default;
+	BulletinReader & operator=(BulletinReader &&) = default;
+
+	// Reads and parses next report; returns false if there are no more
+	// reports in the input; the result, report text and offset are valid
+	// until the next call
+	inline bool next(size_t groupLimit = 200);
+	// Same as next() but only finds the report without parsing it
+	inline bool nextReport();
+	// Splits input into report texts which refer to the input, e.g. to
+	// parse a mapped file with BulkParser without copying the reports
+	static inline std::vector<std::string_view> splitReports(
+		std::string_view input);
+	const ParseResult & result() const { return context.result(); }
+	std::string_view reportText() const { return report; }
+	// Byte offset of the first report char from the beginning of the input
+	uint64_t reportOffset() const { return offset; }
+	// True if reading from input failed (as opposed to reaching its end)
+	bool isError() const { return readError; }
+	// Number of reports skipped because they were longer than the maximum
+	// report size
+	uint64_t skippedReports() const { return skipped; }
+
+private:
+	inline bool findReportStart();
+	inline size_t findReportEnd(size_t & separatorSize);
+	inline void refill();
+	inline bool growBuffer();
+	inline void discardScanned();
+	inline size_t readInput(char * data, size_t size);
+
+	std::istream * stream = nullptr;
+	int fd = -1;
+	std::vector<char> buffer;
+	// Points to the buffer or to the input passed as string_view
+	const char * data = nullptr;
+	// Unprocessed data is in range [begin, end) of the data
+	size_t begin = 0;
+	size_t end = 0;
+	// Position from which search for report end continues after refill
+	size_t scanPos = 0;
+	// Input offset of data[0]
+	uint64_t bufferOffset = 0;
+	bool inputEnd = false;
+	bool readError = false;
+	size_t maxReport = std::numeric_limits<size_t>::max();
+	uint64_t skipped = 0;
+
+	ParserContext context;
+	std::string_view report;
+	uint64_t offset = 0;
+};
+
+#ifdef METAF_POSIX_MMAP
+// Read-only memory mapping of a regular file; mapped data is passed to
+// BulletinReader or BulletinReader::splitReports as a string_view, so that
+// reports are parsed directly from the page cache instead of being copied
+// into heap strings first
+// Kernel is advised of sequential access; huge pages are requested only if
+// hugePages is true and are a hint which may be ignored for file mappings
+class MappedFile {
+public:
+	explicit inline MappedFile(const char * path, bool hugePages = false);
+	inline ~MappedFile();
+	MappedFile(const MappedFile &) = delete;
+	MappedFile & operator=(const MappedFile &) = delete;
+
+	bool isOpen() const { return !errorCode; }
+	// Value of errno if opening or mapping the file failed, zero otherwise
+	int error() const { return errorCode; }
+	std::string_view data() const {
+		return std::string_view(static_cast<const char *>(address), length);
+	}
+
+private:
+	void * address = nullptr;
+	size_t length = 0;
+	int errorCode = 0;
+};
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+WorkStealingPool::WorkStealingPool(size_t threadCount) {
+	if (!threadCount) threadCount = 1;
+	queues.reserve(threadCount);
+	for (auto i = 0u; i < threadCount; i++)
+		queues.push_back(std::make_unique<TaskQueue>());
+	workers.reserve(threadCount);
+	for (auto i = 0u; i < threadCount; i++)
+		workers.emplace_back([this, i](){ workerLoop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	taskAvailable.notify_all();
+	for (auto & w : workers) w.join();
+}
+
+void WorkStealingPool::run(size_t taskCount,
+	const std::function<void(size_t)> & task)
+{
+	if (!taskCount) return;
+	std::lock_guard<std::mutex> runLock(runMutex);
+	// Consecutive tasks go to the same worker to keep its input hot in cache
+	const auto tasksPerWorker = (taskCount + queues.size() - 1) / queues.size();
+	for (auto i = 0u; i < queues.size(); i++) {
+		std::lock_guard<std::mutex> lock(queues[i]->mutex);
+		const auto begin = i * tasksPerWorker;
+		for (auto t = begin; t < begin + tasksPerWorker && t < taskCount; t++)
+			queues[i]->tasks.push_back(t);
+	}
+	std::unique_lock<std::mutex> lock(mutex);
+	currentTask = &task;
+	remainingTasks = taskCount;
+	taskError = nullptr;
+	generation++;
+	taskAvailable.notify_all();
+	// Wait for workers to leave the batch as well, otherwise a worker still
+	// looking for tasks could take a task of the next batch
+	batchFinished.wait(lock, [this](){
+		return (!remainingTasks && !activeWorkers);
+	});
+	currentTask = nullptr;
+	if (taskError) std::rethrow_exception(taskError);
+}
+
+void WorkStealingPool::workerLoop(size_t workerIndex) {
+	size_t seenGeneration = 0;
+	while (true) {
+		const std::function<void(size_t)> * task = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			taskAvailable.wait(lock, [&](){
+				return (stopping || generation != seenGeneration);
+			});
+			if (stopping) return;
+			seenGeneration = generation;
+			// Batch is already finished if the worker woke up late
+			if (!currentTask) continue;
+			task = currentTask;
+			activeWorkers++;
+		}
+		size_t taskIndex = 0;
+		while (takeTask(workerIndex, taskIndex)) {
+			try {
+				(*task)(taskIndex);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!taskError) taskError = std::current_exception();
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			remainingTasks--;
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!--activeWorkers && !remainingTasks) batchFinished.notify_all();
+	}
+}
+
+bool WorkStealingPool::takeTask(size_t workerIndex, size_t & taskIndex) {
+	{
+		// Own tasks are taken from the front
+		auto & own = *queues[workerIndex];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty()) {
+			taskIndex = own.tasks.front();
+			own.tasks.pop_front();
+			return true;
+		}
+	}
+	for (auto i = 1u; i < queues.size(); i++) {
+		// Tasks of other workers are stolen from the back
+		auto & other = *queues[(workerIndex + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(other.mutex);
+		if (!other.tasks.empty()) {
+			taskIndex = other.tasks.back();
+			other.tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename Reports>
+std::vector<ParseResult> BulkParser::parse(const Reports & reports,
+	size_t groupLimit)
+{
+	// Parser has no mutable shared state (function-local statics are
+	// constant tables initialised once in a thread-safe way), so chunks can
+	// be parsed concurrently; each task writes only its own results
+	std::vector<ParseResult> results(reports.size());
+	const auto chunkCount = (reports.size() + chunk - 1) / chunk;
+	pool.run(chunkCount, [&](size_t chunkIndex){
+		const auto begin = chunkIndex * chunk;
+		const auto end = std::min(begin + chunk, reports.size());
+		for (auto i = begin; i < end; i++)
+			results[i] = Parser::parse(std::string_view(reports[i]), groupLimit);
+	});
+	return results;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool BulletinReader::next(size_t groupLimit) {
+	if (!nextReport()) return false;
+	Parser::parse(report, context, groupLimit);
+	return true;
+}
+
+bool BulletinReader::nextReport() {
+	while (findReportStart()) {
+		scanPos = begin;
+		size_t separatorSize = 0;
+		size_t reportEnd = findReportEnd(separatorSize);
+		// Once the report is known to be too long, its scanned part is
+		// discarded while its end is searched for
+		bool tooLong = false;
+		while (reportEnd == std::string_view::npos && !inputEnd) {
+			const bool bufferFull = (!begin && end == buffer.size());
+			if (!tooLong && bufferFull) {
+				// Either scanned report text or whitespace after the line
+				// break which ends it is longer than maximum report size
+				tooLong = (scanPos - begin > maxReport || !growBuffer());
+			}
+			if (tooLong) discardScanned();
+			refill();
+			reportEnd = findReportEnd(separatorSize);
+		}
+		if (reportEnd == std::string_view::npos) reportEnd = end;
+		if (tooLong || reportEnd - begin > maxReport) {
+			skipped++;
+			begin = reportEnd + separatorSize;
+			continue;
+		}
+		report = std::string_view(data + begin, reportEnd - begin);
+		offset = bufferOffset + begin;
+		begin = reportEnd + separatorSize;
+		return true;
+	}
+	return false;
+}
+
+std::vector<std::string_view> BulletinReader::splitReports(
+	std::string_view input)
+{
+	std::vector<std::string_view> reports;
+	BulletinReader reader(input);
+	while (reader.nextReport()) reports.push_back(reader.reportText());
+	return reports;
+}
+
+bool BulletinReader::findReportStart() {
+	while (true) {
+		// Delimiters and report end chars between reports are skipped
+		while (begin < end &&
+			(data[begin] <= groupDelimiterChar || data[begin] == reportEndChar))
+				begin++;
+		if (begin < end) return true;
+		if (inputEnd) return false;
+		refill();
+	}
+}
+
+size_t BulletinReader::findReportEnd(size_t & separatorSize) {
+	for (auto i = scanPos; i < end; i++) {
+		if (data[i] == reportEndChar) {
+			separatorSize = 1;
+			return i;
+		}
+		if (data[i] != '\n') continue;
+		// Blank line is a line break followed by another line break,
+		// optionally with spaces, tabs or carriage returns in between
+		auto j = i + 1;
+		while (j < end && (data[j] == ' ' || data[j] == '\t' || data[j] == '\r'))
+			j++;
+		if (j == end && !inputEnd) {
+			// Not known yet whether this is a blank line
+			scanPos = i;
+			return std::string_view::npos;
+		}
+		if (j < end && data[j] == '\n') {
+			separatorSize = j + 1 - i;
+			return i;
+		}
+	}
+	scanPos = end;
+	return std::string_view::npos;
+}
+
+void BulletinReader::refill() {
+	if (begin) {
+		// Move unprocessed data to the beginning of the buffer
+		std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+		bufferOffset += begin;
+		scanPos -= (scanPos > begin ? begin : scanPos);
+		end -= begin;
+		begin = 0;
+	}
+	const auto bytesRead = readInput(buffer.data() + end, buffer.size() - end);
+	if (!bytesRead) inputEnd = true;
+	end += bytesRead;
+}
+
+bool BulletinReader::growBuffer() {
+	// Buffer holds a report of maximum size, the line break after it and
+	// more whitespace than maximum report size
+	const auto maxSize = (maxReport < std::numeric_limits<size_t>::max() / 2 - 1) ?
+		std::max(buffer.size(), 2 * (maxReport + 1)) :
+		std::numeric_limits<size_t>::max();
+	if (buffer.size() >= maxSize) return false;
+	const auto size = std::min(maxSize, std::max(buffer.size() * 2, buffer.size() + 1));
+	buffer.resize(size);
+	data = buffer.data();
+	return true;
+}
+
+void BulletinReader::discardScanned() {
+	if (scanPos > begin) {
+		begin = scanPos;
+		return;
+	}
+	// Only a line break followed by whitespace is left: it is not known yet
+	// whether this is a blank line, so the line break is moved past the
+	// whitespace, which does not change that and frees the buffer; offsets
+	// of data after it are not changed
+	if (begin == scanPos && end > begin + 1 && end == buffer.size()) {
+		buffer[end - 1] = '\n';
+		begin = scanPos = end - 1;
+	}
+}
+
+size_t BulletinReader::readInput(char * data, size_t size) {
+	if (!size) return 0;
+	if (stream) {
+		// Only data already available is read, so that a complete report is
+		// returned without waiting for more input from a pipe or socket
+		auto bytesRead = stream->readsome(data, size);
+		if (!bytesRead && stream->good()) {
+			// Nothing is available: wait for one char, then read the data
+			// which became available with it
+			stream->read(data, 1);
+			bytesRead = stream->gcount();
+			if (bytesRead && size > 1) bytesRead += stream->readsome(data + 1, size - 1);
+		}
+		if (stream->bad()) readError = true;
+		return bytesRead;
+	}
+#ifdef METAF_POSIX_IO
+	while (true) {
+		const auto bytesRead = ::read(fd, data, size);
+		if (bytesRead >= 0) return bytesRead;
+		if (errno == EINTR) continue;
+		readError = true;
+		return 0;
+	}
+#else
+	return 0;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef METAF_POSIX_MMAP
+MappedFile::MappedFile(const char * path, bool hugePages) {
+	const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		errorCode = errno;
+		return;
+	}
+	struct stat fileStat;
+	if (::fstat(fd, &fileStat)) {
+		errorCode = errno;
+		::close(fd);
+		return;
+	}
+	// Empty file cannot be mapped and is represented by empty data
+	if (fileStat.st_size > 0) {
+		length = fileStat.st_size;
+		address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (address == MAP_FAILED) {
+			errorCode = errno;
+			address = nullptr;
+			length = 0;
+		}
+	}
+	// Mapping remains valid after the file descriptor is closed
+	::close(fd);
+	if (!address) return;
+	::madvise(address, length, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+	if (hugePages) ::madvise(address, length, MADV_HUGEPAGE);
+#else
+	(void)hugePages;
+#endif
+}
+
+MappedFile::~MappedFile() {
+	if (address) ::munmap(address, length);
+}
+#endif
+
+} //namespace metaf
+
+#endif //#ifndef METAF_BULK_HPP
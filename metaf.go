@@ -43,6 +43,8 @@ typedef _gostring_ swig_type_13;
 typedef _gostring_ swig_type_14;
 typedef _gostring_ swig_type_15;
 typedef _gostring_ swig_type_16;
+typedef _gostring_ swig_type_17;
+typedef _gostring_ swig_type_18;
 extern void _wrap_Swig_free_metaf_40ca0f57843643fc(uintptr_t arg1);
 extern uintptr_t _wrap_Swig_malloc_metaf_40ca0f57843643fc(swig_intgo arg1);
 extern uintptr_t _wrap_new_StringVector__SWIG_0_metaf_40ca0f57843643fc(void);
@@ -82,6 +84,7 @@ extern uintptr_t _wrap_MetafResult_rawGroups_get_metaf_40ca0f57843643fc(uintptr_
 extern uintptr_t _wrap_new_MetafResult_metaf_40ca0f57843643fc(void);
 extern void _wrap_delete_MetafResult_metaf_40ca0f57843643fc(uintptr_t arg1);
 extern uintptr_t _wrap_ParseMetaf_metaf_40ca0f57843643fc(swig_type_16 arg1);
+extern swig_type_17 _wrap_ParseMetafBatch_metaf_40ca0f57843643fc(swig_type_18 arg1);
 #undef intgo
 */
 import "C"
@@ -496,4 +499,17 @@ func ParseMetaf(arg1 string) (_swig_ret MetafResult) {
 	return swig_r
 }
 
+func ParseMetafBatch(arg1 string) (_swig_ret string) {
+	var swig_r string
+	_swig_i_0 := arg1
+	swig_r_p := C._wrap_ParseMetafBatch_metaf_40ca0f57843643fc(*(*C.swig_type_18)(unsafe.Pointer(&_swig_i_0)))
+	swig_r = *(*string)(unsafe.Pointer(&swig_r_p))
+	if Swig_escape_always_false {
+		Swig_escape_val = arg1
+	}
+	var swig_r_1 string
+ swig_r_1 = swigCopyString(swig_r) 
+	return swig_r_1
+}
+
 
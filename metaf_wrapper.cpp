@@ -1,14 +1,20 @@
 // metaf_wrapper.cpp
 #include "metaf_wrapper.hpp"
 #include "./include/metaf.hpp"
+#include <array>
+#include <memory_resource>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
-// Visitor class to extract information from groups
-class SimpleVisitor : public metaf::Visitor<std::string> {
+// Visitor class to extract information from groups; visit functions are
+// called without virtual dispatch
+class SimpleVisitor : public metaf::StaticVisitor<SimpleVisitor, std::string> {
 private:
-    std::string visitKeywordGroup(const metaf::KeywordGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    friend class metaf::StaticVisitor<SimpleVisitor, std::string>;
+
+    std::string visitKeywordGroup(const metaf::KeywordGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         switch (group.type()) {
             case metaf::KeywordGroup::Type::METAR:
                 return "Report type: METAR (weather observation report)";
@@ -31,11 +37,11 @@ private:
         }
     }
 
-    std::string visitLocationGroup(const metaf::LocationGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitLocationGroup(const metaf::LocationGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "ICAO airport code: " + group.toString();
     }
 
-    std::string visitReportTimeGroup(const metaf::ReportTimeGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitReportTimeGroup(const metaf::ReportTimeGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         std::ostringstream result;
         const auto& time = group.time();
 
@@ -49,7 +55,7 @@ private:
         return result.str();
     }
 
-    std::string visitWindGroup(const metaf::WindGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitWindGroup(const metaf::WindGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         std::ostringstream result;
 
         if (group.type() == metaf::WindGroup::Type::SURFACE_WIND_CALM) {
@@ -93,7 +99,7 @@ private:
         return result.str();
     }
 
-    std::string visitVisibilityGroup(const metaf::VisibilityGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitVisibilityGroup(const metaf::VisibilityGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         std::ostringstream result;
 
         switch (group.type()) {
@@ -321,7 +327,7 @@ private:
         return result.str();
     }
 
-    std::string visitCloudGroup(const metaf::CloudGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitCloudGroup(const metaf::CloudGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         std::ostringstream result;
 
         switch (group.type()) {
@@ -419,7 +425,7 @@ private:
         return result.str();
     }
 
-    std::string visitTemperatureGroup(const metaf::TemperatureGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitTemperatureGroup(const metaf::TemperatureGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         std::ostringstream result;
 
         result << "Temperature: ";
@@ -451,7 +457,7 @@ private:
         return result.str();
     }
 
-    std::string visitPressureGroup(const metaf::PressureGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitPressureGroup(const metaf::PressureGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         std::ostringstream result;
 
         result << "Pressure: ";
@@ -478,7 +484,7 @@ private:
         return result.str();
     }
 
-    std::string visitWeatherGroup(const metaf::WeatherGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitWeatherGroup(const metaf::WeatherGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         std::ostringstream result;
 
         if (group.type() == metaf::WeatherGroup::Type::NSW) {
@@ -602,7 +608,7 @@ private:
         return result.str();
     }
 
-    std::string visitCloudTypesGroup(const metaf::CloudTypesGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitCloudTypesGroup(const metaf::CloudTypesGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         std::ostringstream result;
         result << "Obscuration / cloud layers:";
 
@@ -682,62 +688,82 @@ private:
         return result.str();
     }
 
-    std::string visitMiscGroup(const metaf::MiscGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitMiscGroup(const metaf::MiscGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Additional information: " + rawString;
     }
 
-    std::string visitUnknownGroup(const metaf::UnknownGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitUnknownGroup(const metaf::UnknownGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Unknown group: " + rawString;
     }
 
     // Default implementations for other group types
-    std::string visitTrendGroup(const metaf::TrendGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitTrendGroup(const metaf::TrendGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Trend information: " + rawString;
     }
 
-    std::string visitRunwayStateGroup(const metaf::RunwayStateGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitRunwayStateGroup(const metaf::RunwayStateGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Runway state: " + rawString;
     }
 
-    std::string visitSeaSurfaceGroup(const metaf::SeaSurfaceGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitSeaSurfaceGroup(const metaf::SeaSurfaceGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Sea surface conditions: " + rawString;
     }
 
-    std::string visitMinMaxTemperatureGroup(const metaf::MinMaxTemperatureGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitMinMaxTemperatureGroup(const metaf::MinMaxTemperatureGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Min/Max temperature: " + rawString;
     }
 
-    std::string visitPrecipitationGroup(const metaf::PrecipitationGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitPrecipitationGroup(const metaf::PrecipitationGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Precipitation information: " + rawString;
     }
 
-    std::string visitLayerForecastGroup(const metaf::LayerForecastGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitLayerForecastGroup(const metaf::LayerForecastGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Layer forecast: " + rawString;
     }
 
-    std::string visitPressureTendencyGroup(const metaf::PressureTendencyGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitPressureTendencyGroup(const metaf::PressureTendencyGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Pressure tendency: " + rawString;
     }
 
-    std::string visitLowMidHighCloudGroup(const metaf::LowMidHighCloudGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitLowMidHighCloudGroup(const metaf::LowMidHighCloudGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Low/Mid/High clouds: " + rawString;
     }
 
-    std::string visitLightningGroup(const metaf::LightningGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitLightningGroup(const metaf::LightningGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Lightning: " + rawString;
     }
 
-    std::string visitVicinityGroup(const metaf::VicinityGroup & group, metaf::ReportPart reportPart, const std::string & rawString) override {
+    std::string visitVicinityGroup(const metaf::VicinityGroup & group, metaf::ReportPart reportPart, const std::string & rawString) {
         return "Vicinity observations: " + rawString;
     }
 };
 
+// Per-thread arena for parse results; the buffer fits a typical report so
+// that parsing does not touch the heap
+struct ParseArena {
+    std::array<std::byte, 16384> buffer;
+    std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size()};
+};
+
+static thread_local ParseArena parseArena;
+
+// Releases the arena once the parse result using it has been destroyed
+class ArenaReleaser {
+public:
+    explicit ArenaReleaser(std::pmr::monotonic_buffer_resource & r) : resource(r) {}
+    ~ArenaReleaser() { resource.release(); }
+private:
+    std::pmr::monotonic_buffer_resource & resource;
+};
+
 // Parse a METAR/TAF report and return a structured result
-MetafResult ParseMetaf(const std::string& report) {
+static MetafResult parseReport(std::string_view report) {
     MetafResult result;
 
-    // Parse the report using metaf library
-    auto parseResult = metaf::Parser::parse(report);
+    // Parse the report using metaf library into a per-thread arena which is
+    // released after the result is converted
+    ArenaReleaser arenaReleaser(parseArena.resource);
+    const auto parseResult = metaf::Parser::parse(report, &parseArena.resource);
 
     // Extract metadata
     switch (parseResult.reportMetadata.type) {
@@ -805,7 +831,8 @@ MetafResult ParseMetaf(const std::string& report) {
     // Process each parsed group
     for (const auto& groupInfo : parseResult.groups) {
         // Get explanation for the group
-        std::string explanation = visitor.visit(groupInfo.group, groupInfo.reportPart, groupInfo.rawString);
+        const std::string rawString(groupInfo.rawString);
+        std::string explanation = visitor.visit(groupInfo.group, groupInfo.reportPart, rawString);
 
         // Add raw group and explanation to the result
         result.rawGroups.push_back(explanation);
@@ -813,3 +840,51 @@ MetafResult ParseMetaf(const std::string& report) {
 
     return result;
 }
+
+MetafResult ParseMetaf(const std::string& report) {
+    return parseReport(report);
+}
+
+// Separators of the packed batch format; metaf treats all control characters
+// as group delimiters so separators never appear in raw groups, and the
+// explanations never contain them (though they may contain '\n')
+static const char batchReportSeparator = '\x1e';
+static const char batchFieldSeparator = '\x1f';
+static const char batchGroupSeparator = '\x1d';
+
+static void appendPacked(std::string& packed, const MetafResult& result) {
+    packed += result.reportType;
+    packed += batchFieldSeparator;
+    packed += result.error;
+    packed += batchFieldSeparator;
+    packed += result.location;
+    packed += batchFieldSeparator;
+    packed += result.timestamp;
+    packed += batchFieldSeparator;
+    for (const bool flag : { result.isSpeci, result.isAutomated, result.isNil,
+            result.isCancelled, result.isAmended, result.isCorrectional })
+        packed += flag ? '1' : '0';
+    packed += batchFieldSeparator;
+    for (size_t i = 0; i < result.rawGroups.size(); i++) {
+        if (i) packed += batchGroupSeparator;
+        packed += result.rawGroups[i];
+    }
+    packed += batchReportSeparator;
+}
+
+// Parse newline-separated METAR/TAF reports and pack the results
+std::string ParseMetafBatch(const std::string& reports) {
+    std::string packed;
+    // Explanations are typically several times longer than raw reports
+    packed.reserve(reports.size() * 4);
+
+    const std::string_view input(reports);
+    size_t begin = 0;
+    while (true) {
+        const auto end = input.find('\n', begin);
+        appendPacked(packed, parseReport(input.substr(begin, end - begin)));
+        if (end == std::string_view::npos) break;
+        begin = end + 1;
+    }
+    return packed;
+}
@@ -25,4 +25,14 @@ struct MetafResult {
 // Parse a METAR/TAF report
 MetafResult ParseMetaf(const std::string& report);
 
+// Parse a batch of newline-separated METAR/TAF reports in a single call.
+// Each line produces one result and all results are packed into one string:
+// every result ends with '\x1e', its fields are separated by '\x1f' in the
+// order reportType, error, location, timestamp, flags, groups. Flags are six
+// '0'/'1' chars for isSpeci, isAutomated, isNil, isCancelled, isAmended and
+// isCorrectional; group explanations are separated by '\x1d'. Only these three
+// control characters are separators and they never occur in the fields;
+// explanations may contain other control characters such as '\n'.
+std::string ParseMetafBatch(const std::string& reports);
+
 #endif // METAF_WRAPPER_HPP
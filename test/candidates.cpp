@@ -0,0 +1,99 @@
+// candidates.cpp
+// Checks the first char table of GroupParser::candidates(): a group which
+// parse() of an alternative recognises must have that alternative among its
+// candidates, otherwise the parser would never try it
+// Groups checked are the groups of a corpus, each with its first char
+// replaced by every char and with every char prepended, in each report part
+// Usage: candidates <corpus>
+#include "../include/metaf.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace metaf;
+
+namespace {
+
+const ReportPart reportParts[] = {
+    ReportPart::UNKNOWN,
+    ReportPart::HEADER,
+    ReportPart::METAR,
+    ReportPart::TAF,
+    ReportPart::RMK
+};
+
+// Alternatives which recognise the group but are not its candidates
+template <size_t... I>
+GroupTypeMask missedAlternatives(std::string_view group,
+    ReportPart reportPart,
+    const ReportMetadata & reportMetadata,
+    std::index_sequence<I...>)
+{
+    const auto candidates = GroupParser::candidates(group, reportPart);
+    GroupTypeMask missed = 0;
+    ((missed |= (!(candidates & (1u << I)) &&
+        std::variant_alternative_t<I, Group>::parse(group, reportPart, reportMetadata).has_value()) ?
+            (1u << I) : 0u), ...);
+    return missed;
+}
+
+} // namespace
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <corpus>\n";
+        return 1;
+    }
+    std::ifstream corpus(argv[1]);
+    if (!corpus) {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return 1;
+    }
+    std::set<std::string> groups;
+    std::string line;
+    while (std::getline(corpus, line)) {
+        std::istringstream report(line);
+        std::string group;
+        while (report >> group) groups.insert(group);
+    }
+
+    // Some groups in remarks are only recognised if report time is known
+    ReportMetadata withoutTime;
+    ReportMetadata withTime;
+    withTime.reportTime = MetafTime::fromStringDDHHMM("081700");
+
+    // FallbackGroup recognises any group and is not in the table
+    const auto alternatives =
+        std::make_index_sequence<std::variant_size_v<Group> - 1>();
+    size_t checked = 0, failures = 0;
+    std::string variant;
+    for (const auto & group : groups) {
+        for (auto c = 0u; c < 256; c++) {
+            for (const auto prepend : {false, true}) {
+                variant = group;
+                if (prepend) variant.insert(variant.begin(), static_cast<char>(c));
+                else variant[0] = static_cast<char>(c);
+                for (const auto reportPart : reportParts) {
+                    for (const auto * metadata : {&withoutTime, &withTime}) {
+                        checked++;
+                        const auto missed =
+                            missedAlternatives(variant, reportPart, *metadata, alternatives);
+                        if (!missed) continue;
+                        if (failures++ < 10) {
+                            std::cerr << "Group '" << variant << "' in report part "
+                                << static_cast<int>(reportPart)
+                                << " is recognised by alternatives 0x" << std::hex << missed
+                                << std::dec << " which are not its candidates\n";
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::printf("%zu groups checked, %zu missed by candidates\n", checked, failures);
+    return (failures ? 1 : 0);
+}
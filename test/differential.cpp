@@ -0,0 +1,263 @@
+// differential.cpp
+// Dumps the full parse result (report metadata, and for each group its report
+// part, raw string, alternative and the values of all its accessors) of each
+// report in a corpus, and compares the dump with the expected one
+// test/expected.txt was dumped from test/corpus.txt by the parser which still
+// used std::regex; it is only regenerated when parser output is meant to change
+// Usage: differential <corpus> [expected dump]
+// Without expected dump, the dump is written to stdout
+#include "../include/metaf.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace metaf;
+
+namespace {
+
+template <typename E>
+int toInt(E e) { return static_cast<int>(e); }
+
+class Dump {
+public:
+    std::string report(const ParseResult & result);
+
+    void operator()(const KeywordGroup & g) { out << "KW " << toInt(g.type()); }
+    void operator()(const LocationGroup & g) { out << "LOC " << g.toString(); }
+    void operator()(const ReportTimeGroup & g) { out << "RT "; time(g.time()); }
+    void operator()(const TrendGroup & g) {
+        out << "TR " << toInt(g.type()) << " " << toInt(g.probability()) << " ";
+        time(g.timeFrom()); time(g.timeUntil()); time(g.timeAt());
+        out << g.isTimeSpanGroup();
+    }
+    void operator()(const WindGroup & g) {
+        out << "WI " << toInt(g.type()) << " ";
+        direction(g.direction()); speed(g.windSpeed()); speed(g.gustSpeed());
+        distance(g.height()); direction(g.varSectorBegin()); direction(g.varSectorEnd());
+        time(g.eventTime()); runway(g.runway());
+    }
+    void operator()(const VisibilityGroup & g) {
+        out << "VI " << toInt(g.type()) << " ";
+        distance(g.visibility()); distance(g.minVisibility()); distance(g.maxVisibility());
+        direction(g.direction()); runway(g.runway());
+        for (const auto & d : g.sectorDirections()) direction(d);
+        out << toInt(g.trend());
+    }
+    void operator()(const CloudGroup & g) {
+        out << "CL " << toInt(g.type()) << " " << toInt(g.amount()) << " " << toInt(g.convectiveType()) << " ";
+        distance(g.height()); distance(g.minHeight()); distance(g.maxHeight());
+        distance(g.verticalVisibility());
+        if (const auto c = g.cloudType(); c) cloudType(*c); else out << "ct-";
+        runway(g.runway()); direction(g.direction());
+    }
+    void operator()(const WeatherGroup & g) {
+        out << "WX " << toInt(g.type()) << " ";
+        for (const auto & w : g.weatherPhenomena()) weatherPhenomena(w);
+    }
+    void operator()(const TemperatureGroup & g) {
+        out << "TE " << toInt(g.type()) << " ";
+        temperature(g.airTemperature()); temperature(g.dewPoint());
+        number(g.relativeHumidity());
+    }
+    void operator()(const PressureGroup & g) {
+        out << "PR " << toInt(g.type()) << " "; pressure(g.atmosphericPressure());
+    }
+    void operator()(const RunwayStateGroup & g) {
+        out << "RS "; runway(g.runway());
+        out << toInt(g.type()) << toInt(g.deposits()) << toInt(g.contaminationExtent());
+        precipitation(g.depositDepth());
+        const auto s = g.surfaceFriction();
+        out << "sf(" << toInt(s.type()); number(s.coefficient());
+        out << toInt(s.brakingAction()) << s.isReported() << s.isUnreliable() << ")";
+    }
+    void operator()(const SeaSurfaceGroup & g) {
+        out << "SS "; temperature(g.surfaceTemperature());
+        const auto w = g.waves();
+        out << "wh(" << toInt(w.type()) << toInt(w.stateOfSurface()) << toInt(w.unit());
+        number(w.waveHeight()); out << w.isReported();
+        number(w.toUnit(WaveHeight::Unit::FEET)); out << ")";
+    }
+    void operator()(const MinMaxTemperatureGroup & g) {
+        out << "MM " << toInt(g.type()) << " ";
+        temperature(g.minimum()); time(g.minimumTime());
+        temperature(g.maximum()); time(g.maximumTime());
+    }
+    void operator()(const PrecipitationGroup & g) {
+        out << "PC " << toInt(g.type()) << " "; precipitation(g.total()); precipitation(g.recent());
+    }
+    void operator()(const LayerForecastGroup & g) {
+        out << "LF " << toInt(g.type()) << " "; distance(g.baseHeight()); distance(g.topHeight());
+    }
+    void operator()(const PressureTendencyGroup & g) {
+        out << "PT " << toInt(g.type()) << " "; pressure(g.difference());
+        out << toInt(PressureTendencyGroup::trend(g.type()));
+    }
+    void operator()(const CloudTypesGroup & g) {
+        out << "CT "; for (const auto & c : g.cloudTypes()) cloudType(c);
+    }
+    void operator()(const LowMidHighCloudGroup & g) {
+        out << "LM " << toInt(g.lowLayer()) << toInt(g.midLayer()) << toInt(g.highLayer());
+    }
+    void operator()(const LightningGroup & g) {
+        out << "LT " << toInt(g.frequency()) << " "; distance(g.distance());
+        out << g.isCloudGround() << g.isInCloud() << g.isCloudCloud() << g.isCloudAir() << g.isUnknownType();
+        for (const auto & d : g.directions()) direction(d);
+    }
+    void operator()(const VicinityGroup & g) {
+        out << "VC " << toInt(g.type()) << " "; distance(g.distance());
+        for (const auto & d : g.directions()) direction(d);
+        direction(g.movingDirection());
+    }
+    void operator()(const MiscGroup & g) { out << "MI " << toInt(g.type()) << " "; number(g.data()); }
+    void operator()(const UnknownGroup &) { out << "UN"; }
+
+private:
+    void number(std::optional<float> f) {
+        if (!f) { out << "-"; return; }
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.6g", *f);
+        out << buffer;
+    }
+    void number(std::optional<unsigned int> u) { if (u) out << *u; else out << "-"; }
+    void time(const MetafTime & t) {
+        out << "T("; number(t.day());
+        out << "," << t.hour() << "," << t.minute() << "," << t.isValid()
+            << t.is3hourlyReportTime() << t.is6hourlyReportTime() << ")";
+    }
+    void time(const std::optional<MetafTime> & t) { if (t) time(*t); else out << "T-"; }
+    void temperature(const Temperature & t) {
+        out << "t("; number(t.temperature());
+        out << "," << toInt(t.unit()) << t.isFreezing() << t.isPrecise() << t.isReported() << ",";
+        number(t.toUnit(Temperature::Unit::F)); out << ")";
+    }
+    void speed(const Speed & s) {
+        out << "s("; number(s.speed());
+        out << "," << toInt(s.unit()) << s.isReported() << ",";
+        number(s.toUnit(Speed::Unit::KILOMETERS_PER_HOUR)); out << ")";
+    }
+    void distance(const Distance & d) {
+        out << "d("; number(d.distance());
+        out << "," << toInt(d.unit()) << "," << toInt(d.modifier()) << d.isValue() << d.isReported() << ",";
+        number(d.toUnit(Distance::Unit::FEET));
+        if (const auto m = d.miles(); m) out << "," << m->first << "/" << toInt(m->second);
+        out << ")";
+    }
+    void direction(const Direction & d) {
+        out << "D(" << toInt(d.type()) << "," << toInt(d.cardinal()) << toInt(d.cardinal(true)) << ",";
+        number(d.degrees()); out << d.isValue() << d.isReported() << d.isValid() << ")";
+    }
+    void direction(const std::optional<Direction> & d) { if (d) direction(*d); else out << "D-"; }
+    void pressure(const Pressure & p) {
+        out << "p("; number(p.pressure());
+        out << "," << toInt(p.unit()) << p.isReported() << ",";
+        number(p.toUnit(Pressure::Unit::MM_HG)); out << ")";
+    }
+    void precipitation(const Precipitation & p) {
+        out << "pr("; number(p.amount());
+        out << "," << toInt(p.unit()) << p.isReported() << ",";
+        number(p.toUnit(Precipitation::Unit::MM)); out << ")";
+    }
+    void runway(const Runway & r) {
+        out << "R(" << r.number() << "," << toInt(r.designator()) << r.isValid()
+            << r.isAllRunways() << r.isMessageRepetition() << ")";
+    }
+    void runway(const std::optional<Runway> & r) { if (r) runway(*r); else out << "R-"; }
+    void cloudType(const CloudType & c) {
+        out << "ct(" << toInt(c.type()) << ","; distance(c.height());
+        out << "," << c.okta() << c.isValid() << ")";
+    }
+    void weatherPhenomena(const WeatherPhenomena & w) {
+        out << "wp(" << toInt(w.qualifier()) << "," << toInt(w.descriptor()) << ",[";
+        for (const auto x : w.weather()) out << toInt(x) << " ";
+        out << "]," << toInt(w.event()) << ","; time(w.time());
+        out << w.isValid() << ")";
+    }
+
+    std::ostringstream out;
+};
+
+std::string Dump::report(const ParseResult & result) {
+    out.str("");
+    const auto & m = result.reportMetadata;
+    out << "# " << toInt(m.type) << " " << toInt(m.error) << " "; time(m.reportTime);
+    out << " " << m.icaoLocation << " " << m.isSpeci << m.isNospeci << m.isAutomated
+        << m.isAo1 << m.isAo1a << m.isAo2 << m.isAo2a << m.isNil << m.isCancelled
+        << m.isAmended << m.isCorrectional << " ";
+    number(m.correctionNumber);
+    out << m.maintenanceIndicator; time(m.timeSpanFrom); time(m.timeSpanUntil);
+    out << "\n";
+    for (const auto & groupInfo : result.groups) {
+        out << toInt(groupInfo.reportPart) << " [" << groupInfo.rawString << "] "
+            << groupInfo.group.index() << " ";
+        std::visit([this](const auto & g) { out << g.isValid() << " "; }, groupInfo.group);
+        std::visit(*this, groupInfo.group);
+        out << "\n";
+    }
+    return out.str();
+}
+
+// Splits the expected dump into one entry per report
+std::vector<std::string> readExpected(std::istream & input) {
+    std::vector<std::string> entries;
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.compare(0, 2, "# ") || entries.empty()) entries.emplace_back();
+        entries.back() += line;
+        entries.back() += '\n';
+    }
+    return entries;
+}
+
+} // namespace
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <corpus> [expected dump]\n";
+        return 1;
+    }
+    std::ifstream corpus(argv[1]);
+    if (!corpus) {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return 1;
+    }
+    std::vector<std::string> reports;
+    std::string line;
+    while (std::getline(corpus, line)) reports.push_back(line);
+
+    Dump dump;
+    if (argc < 3) {
+        for (const auto & report : reports) std::cout << dump.report(Parser::parse(report));
+        return 0;
+    }
+
+    std::ifstream expectedFile(argv[2]);
+    if (!expectedFile) {
+        std::cerr << "Cannot open " << argv[2] << "\n";
+        return 1;
+    }
+    const auto expected = readExpected(expectedFile);
+    if (expected.size() != reports.size()) {
+        std::cerr << "Expected dump has " << expected.size() << " reports, corpus has "
+            << reports.size() << "\n";
+        return 1;
+    }
+    // Parse results are compared both for a new context per report and for
+    // a context reused between reports
+    ParserContext context;
+    size_t failures = 0;
+    for (size_t i = 0; i < reports.size(); i++) {
+        const auto dumped = dump.report(Parser::parse(reports[i]));
+        const auto dumpedWithContext = dump.report(Parser::parse(reports[i], context));
+        if (dumped == expected[i] && dumpedWithContext == expected[i]) continue;
+        if (failures++ < 10) {
+            std::cerr << "Report " << i + 1 << ": " << reports[i] << "\n"
+                << "expected:\n" << expected[i]
+                << "parsed:\n" << (dumped != expected[i] ? dumped : dumpedWithContext);
+        }
+    }
+    std::printf("%zu reports, %zu differ\n", reports.size(), failures);
+    return (failures ? 1 : 0);
+}